@@ -4,39 +4,129 @@
 
 namespace Volta::Chess {
 
-std::array<Detail::MagicEntry, Square::COUNT()>        Attacks::BishopMagics{};
-std::array<std::array<BitBoard, 512>, Square::COUNT()> Attacks::BishopAttacks{};
+namespace {
 
-std::array<Detail::MagicEntry, Square::COUNT()>         Attacks::RookMagics{};
-std::array<std::array<BitBoard, 4096>, Square::COUNT()> Attacks::RookAttacks{};
+struct RayStep {
+    int file;
+    int rank;
+};
 
-void Attacks::init_magics() {
-    for (std::size_t sq_idx = 0; sq_idx < Square::COUNT(); sq_idx++)
+constexpr std::array<RayStep, 4> BishopSteps = {{{1, 1}, {-1, 1}, {1, -1}, {-1, -1}}};
+constexpr std::array<RayStep, 4> RookSteps   = {{{0, 1}, {0, -1}, {1, 0}, {-1, 0}}};
+
+// Same rays as Detail::generate_bishop_attacks and Detail::generate_rook_attacks, but walked on
+// plain file and rank indices. The tables below are filled at compile time, and the generic
+// shift() costs too many evaluation steps for a hundred thousand entries.
+constexpr BitBoard
+sliding_attacks(const Square sq, const BitBoard occ, const std::array<RayStep, 4>& steps) {
+    BitBoard attacks{};
+
+    for (const RayStep step : steps)
     {
-        BishopMagics[sq_idx]       = find_bishop_magic(Square::from_ordinal(sq_idx));
-        const BitBoard mask        = BishopMasks[sq_idx];
-        BitBoard       curr_subset = 0ULL;
+        int file = sq.file().to_underlying() + step.file;
+        int rank = sq.rank().to_underlying() + step.rank;
 
-        for (std::size_t i = 0; i < 1 << mask.popcount(); i++)
+        while (file >= 0 && file < 8 && rank >= 0 && rank < 8)
         {
-            BishopAttacks[sq_idx][BishopMagics[sq_idx].get_index(curr_subset)] =
-              Detail::generate_bishop_attacks(Square::from_ordinal(sq_idx), curr_subset);
-            curr_subset = (curr_subset - mask) & mask;
+            const BitBoard sq_bb = BitBoard(1ULL << (rank * 8 + file));
+            attacks |= sq_bb;
+
+            if (occ & sq_bb)
+                break;
+
+            file += step.file;
+            rank += step.rank;
         }
     }
+
+    return attacks;
+}
+
+// Index of a blocker subset inside its square's slice. The carry-rippler walk below visits the
+// subsets of a mask in the order of their PEXT compression, so with PEXT the n-th subset simply
+// lands at index n.
+constexpr std::size_t slice_index([[maybe_unused]] const BitBoard      subset,
+                                  [[maybe_unused]] const std::size_t   nth_subset,
+                                  [[maybe_unused]] const BitBoard      mask,
+                                  [[maybe_unused]] const std::uint64_t magic) {
+#if defined(USE_PEXT)
+    return nth_subset;
+#else
+    return (static_cast<std::uint64_t>(subset) * magic) >> (Square::COUNT() - mask.popcount());
+#endif
+}
+
+template<std::size_t TableSize>
+constexpr void fill_slices(std::array<BitBoard, TableSize>&                  attacks,
+                           const std::array<std::uint32_t, Square::COUNT()>& offsets,
+                           const std::array<BitBoard, Square::COUNT()>&      masks,
+                           const std::array<std::uint64_t, Square::COUNT()>& magics,
+                           const std::array<RayStep, 4>&                     steps) {
     for (std::size_t sq_idx = 0; sq_idx < Square::COUNT(); sq_idx++)
     {
-        RookMagics[sq_idx]         = find_rook_magic(Square::from_ordinal(sq_idx));
-        const BitBoard mask        = RookMasks[sq_idx];
-        BitBoard       curr_subset = 0;
+        const BitBoard mask        = masks[sq_idx];
+        BitBoard       curr_subset = 0ULL;
+        std::size_t    nth_subset  = 0;
 
-        for (std::size_t i = 0; i < 1 << mask.popcount(); i++)
+        do
         {
-            RookAttacks[sq_idx][RookMagics[sq_idx].get_index(curr_subset)] =
-              Detail::generate_rook_attacks(Square::from_ordinal(sq_idx), curr_subset);
+            const std::size_t index =
+              offsets[sq_idx] + slice_index(curr_subset, nth_subset++, mask, magics[sq_idx]);
+
+            attacks[index] = sliding_attacks(Square::from_ordinal(sq_idx), curr_subset, steps);
             curr_subset = (curr_subset - mask) & mask;
-        }
+        } while (curr_subset);
     }
 }
 
+template<std::size_t TableSize>
+consteval std::array<BitBoard, TableSize>
+generate_slider_attacks(const Detail::SliderLayout&                  layout,
+                        const std::array<BitBoard, Square::COUNT()>& bishop_masks,
+                        const std::array<BitBoard, Square::COUNT()>& rook_masks) {
+    std::array<BitBoard, TableSize> attacks{};
+
+    fill_slices(attacks, layout.bishop_offsets, bishop_masks, BishopMagicNumbers, BishopSteps);
+    fill_slices(attacks, layout.rook_offsets, rook_masks, RookMagicNumbers, RookSteps);
+
+    return attacks;
+}
+
+consteval std::array<Detail::SliderEntry, Square::COUNT()>
+generate_slider_entries(const BitBoard*                                                    table,
+                        const std::array<std::uint32_t, Square::COUNT()>&                  offsets,
+                        const std::array<BitBoard, Square::COUNT()>&                       masks,
+                        [[maybe_unused]] const std::array<std::uint64_t, Square::COUNT()>& magics) {
+    std::array<Detail::SliderEntry, Square::COUNT()> entries{};
+
+    for (std::size_t sq_idx = 0; sq_idx < Square::COUNT(); sq_idx++)
+    {
+#if defined(USE_PEXT)
+        entries[sq_idx] = {.attacks = table + offsets[sq_idx], .mask = masks[sq_idx]};
+#else
+        entries[sq_idx] = {.attacks = table + offsets[sq_idx],
+                           .mask    = masks[sq_idx],
+                           .magic   = magics[sq_idx],
+                           .shift   = static_cast<std::uint8_t>(Square::COUNT()
+                                                              - masks[sq_idx].popcount())};
+#endif
+    }
+
+    return entries;
+}
+
+}  // namespace
+
+// constinit keeps the tables out of startup code: they are emitted fully initialized into
+// read-only data, which every engine process maps from the same page cache.
+constinit const std::array<BitBoard, Attacks::Layout.table_size> Attacks::SliderAttacks =
+  generate_slider_attacks<Attacks::Layout.table_size>(Layout, BishopMasks, RookMasks);
+
+constinit const std::array<Detail::SliderEntry, Square::COUNT()> Attacks::BishopEntries =
+  generate_slider_entries(SliderAttacks.data(), Layout.bishop_offsets, BishopMasks,
+                          BishopMagicNumbers);
+
+constinit const std::array<Detail::SliderEntry, Square::COUNT()> Attacks::RookEntries =
+  generate_slider_entries(SliderAttacks.data(), Layout.rook_offsets, RookMasks, RookMagicNumbers);
+
 }
@@ -3,6 +3,10 @@
 
 #include <array>
 
+#if defined(USE_PEXT)
+    #include <immintrin.h>
+#endif
+
 #include "bbmanip.hpp"
 #include "bitboard.hpp"
 #include "common.hpp"
@@ -136,16 +140,112 @@ constexpr BitBoard generate_rook_attacks(Square sq, BitBoard occ) {
                                 Direction::WEST());
 }
 
-struct MagicEntry {
-    BitBoard      mask;
-    std::uint64_t magic;
-    std::uint8_t  shift;
+struct SquarePairTables {
+    std::array<std::array<BitBoard, Square::COUNT()>, Square::COUNT()> between;
+    std::array<std::array<BitBoard, Square::COUNT()>, Square::COUNT()> line;
+};
+
+// between[a][b] holds the squares strictly between two aligned squares and line[a][b] the whole
+// rank, file or diagonal through both of them. Both are empty for squares that are not aligned.
+consteval SquarePairTables generate_square_pair_tables() {
+    SquarePairTables tables{};
+
+    constexpr std::array<Direction, 8> directions = {
+      Direction::NORTH(),      Direction::SOUTH(),      Direction::EAST(),
+      Direction::WEST(),       Direction::NORTH_EAST(), Direction::NORTH_WEST(),
+      Direction::SOUTH_EAST(), Direction::SOUTH_WEST()};
+
+    for (std::size_t from = 0; from < Square::COUNT(); from++)
+    {
+        const Square from_sq = Square::from_ordinal(from);
+
+        for (const Direction dir : directions)
+        {
+            const BitBoard full_line = generate_attack_ray(0ULL, from_sq, dir)
+                                     | generate_attack_ray(0ULL, from_sq, dir.reverse())
+                                     | from_sq.to_bb();
+
+            BitBoard ray{};
+            BitBoard sq_bb = from_sq.to_bb();
+
+            while ((sq_bb = shift(sq_bb, dir)))
+            {
+                const std::size_t to = sq_bb.lsb();
+
+                tables.between[from][to] = ray;
+                tables.line[from][to]    = full_line;
+
+                ray |= sq_bb;
+            }
+        }
+    }
+
+    return tables;
+}
+
+// All bishop and rook attack sets live in one contiguous table. Every square owns a slice of
+// 2^popcount(mask) entries, bishops first, instead of a fixed 512 or 4096 entry row.
+struct SliderLayout {
+    std::array<std::uint32_t, Square::COUNT()> bishop_offsets;
+    std::array<std::uint32_t, Square::COUNT()> rook_offsets;
+    std::size_t                                table_size;
+};
+
+consteval SliderLayout
+generate_slider_layout(const std::array<BitBoard, Square::COUNT()>& bishop_masks,
+                       const std::array<BitBoard, Square::COUNT()>& rook_masks) {
+    SliderLayout  layout{};
+    std::uint32_t offset = 0;
+
+    for (std::size_t sq_idx = 0; sq_idx < Square::COUNT(); sq_idx++)
+    {
+        layout.bishop_offsets[sq_idx] = offset;
+        offset += 1U << bishop_masks[sq_idx].popcount();
+    }
+
+    for (std::size_t sq_idx = 0; sq_idx < Square::COUNT(); sq_idx++)
+    {
+        layout.rook_offsets[sq_idx] = offset;
+        offset += 1U << rook_masks[sq_idx].popcount();
+    }
+
+    layout.table_size = offset;
+    return layout;
+}
+
+// The base pointer of the square's slice sits next to the magic, so a lookup reads one entry
+// that never straddles a cache line and then one table element.
+struct alignas(32) MagicEntry {
+    const BitBoard* attacks;
+    BitBoard        mask;
+    std::uint64_t   magic;
+    std::uint8_t    shift;
 
-    constexpr std::size_t get_index(BitBoard bb) {
+    constexpr std::size_t get_index(BitBoard bb) const {
         return (static_cast<std::uint64_t>(bb & mask) * magic) >> shift;
     }
 };
 
+#if defined(USE_PEXT)
+
+// With BMI2 the occupancy is compressed by PEXT and used as the index into the slice directly.
+struct alignas(16) PextEntry {
+    const BitBoard* attacks;
+    BitBoard        mask;
+
+    std::size_t get_index(BitBoard bb) const {
+        return _pext_u64(static_cast<std::uint64_t>(bb), static_cast<std::uint64_t>(mask));
+    }
+};
+
+using SliderEntry = PextEntry;
+
+#else
+
+using SliderEntry = MagicEntry;
+
+#endif
+
 }
 
 class Attacks {
@@ -155,15 +255,18 @@ class Attacks {
     static constexpr std::array<BitBoard, Square::COUNT()> KnightAttacks =
       Detail::generate_knight_attacks();
 
+    static constexpr Detail::SquarePairTables SquarePairs = Detail::generate_square_pair_tables();
+
     static constexpr std::array<BitBoard, Square::COUNT()> BishopMasks =
       Detail::generate_bishop_masks();
-    static std::array<Detail::MagicEntry, Square::COUNT()>        BishopMagics;
-    static std::array<std::array<BitBoard, 512>, Square::COUNT()> BishopAttacks;
-
     static constexpr std::array<BitBoard, Square::COUNT()> RookMasks =
       Detail::generate_rook_masks();
-    static std::array<Detail::MagicEntry, Square::COUNT()>         RookMagics;
-    static std::array<std::array<BitBoard, 4096>, Square::COUNT()> RookAttacks;
+
+    static constexpr Detail::SliderLayout Layout =
+      Detail::generate_slider_layout(BishopMasks, RookMasks);
+    static const std::array<BitBoard, Layout.table_size>          SliderAttacks;
+    static const std::array<Detail::SliderEntry, Square::COUNT()> BishopEntries;
+    static const std::array<Detail::SliderEntry, Square::COUNT()> RookEntries;
 
    public:
     static constexpr BitBoard pawn_attacks(BitBoard pawn_bb, Color side) {
@@ -174,25 +277,42 @@ class Attacks {
 
     static constexpr BitBoard king_attacks(Square sq) { return KingAttacks[sq.ordinal()]; }
 
+    static constexpr BitBoard between(Square a, Square b) {
+        return SquarePairs.between[a.ordinal()][b.ordinal()];
+    }
+
+    static constexpr BitBoard line(Square a, Square b) {
+        return SquarePairs.line[a.ordinal()][b.ordinal()];
+    }
+
     static constexpr BitBoard knight_attacks(Square sq) { return KnightAttacks[sq.ordinal()]; }
 
     static constexpr BitBoard bishop_mask(Square sq) { return BishopMasks[sq.ordinal()]; }
 
     static BitBoard bishop_attacks(Square sq, BitBoard occ) {
-        return BishopAttacks[sq.ordinal()][BishopMagics[sq.ordinal()].get_index(occ)];
+        const Detail::SliderEntry& entry = BishopEntries[sq.ordinal()];
+        return entry.attacks[entry.get_index(occ)];
     }
 
     static constexpr BitBoard rook_mask(Square sq) { return RookMasks[sq.ordinal()]; }
 
     static BitBoard rook_attacks(Square sq, BitBoard occ) {
-        return RookAttacks[sq.ordinal()][RookMagics[sq.ordinal()].get_index(occ)];
+        const Detail::SliderEntry& entry = RookEntries[sq.ordinal()];
+        return entry.attacks[entry.get_index(occ)];
+    }
+
+    // Name of the sliding-attack indexing scheme compiled into this binary.
+    static constexpr const char* slider_backend() {
+#if defined(USE_PEXT)
+        return "pext";
+#else
+        return "magic";
+#endif
     }
 
     static BitBoard queen_attacks(Square sq, BitBoard occ) {
         return bishop_attacks(sq, occ) | rook_attacks(sq, occ);
     }
-
-    static void init_magics();
 };
 
 }
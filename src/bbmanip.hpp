@@ -34,6 +34,7 @@ namespace Volta::Chess {
         return (bb & ~File::FILE_A().to_bb()) >> 9;
 
     assert(false);
+    return bb;
 }
 
 template<typename T, typename... Ts>
@@ -41,6 +42,17 @@ template<typename T, typename... Ts>
     return shift(shift(bb, dir), dirs...);
 }
 
+// Smears every bit of `bb` north or south to the edge of the board, the bits themselves included.
+[[nodiscard]] constexpr BitBoard fill(BitBoard bb, const Direction dir) {
+    assert(dir == Direction::NORTH() || dir == Direction::SOUTH());
+
+    bb |= shift(bb, dir);
+    bb |= shift(bb, dir, dir);
+    bb |= shift(bb, dir, dir, dir, dir);
+
+    return bb;
+}
+
 [[nodiscard]] constexpr Square shift(const Square sq, const Direction dir) {
     if (dir == Direction::NORTH())
         return Square::from_ordinal(sq.to_underlying() + 8);
@@ -55,6 +67,7 @@ template<typename T, typename... Ts>
         return Square::from_ordinal(sq.to_underlying() - 1);
 
     assert(false);
+    return sq;
 }
 
 template<typename T, typename... Ts>
@@ -0,0 +1,66 @@
+#ifndef VOLTA_BOOK_HPP__
+#define VOLTA_BOOK_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "move.hpp"
+#include "position.hpp"
+#include "utility.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+// A Polyglot opening book. The file is an array of 16-byte big-endian entries sorted by key:
+//
+//   uint64   Polyglot key of the position
+//   uint16   move: to square (bits 0-5), from square (6-11), promotion piece (12-14)
+//   uint16   weight
+//   uint32   learn data, ignored
+//
+// The file is mapped read-only and binary-searched in place. Nothing is copied to the heap, so
+// opening costs one mmap however large the book is, and processes using the same book share its
+// pages through the page cache.
+class Book {
+   public:
+    Book() = default;
+    ~Book();
+
+    Book(const Book&)            = delete;
+    Book& operator=(const Book&) = delete;
+
+    // Replaces the current book on success and leaves none open on failure, including when the
+    // file size is not a whole number of entries.
+    bool open(const std::string& path);
+    void close();
+
+    bool        is_open() const noexcept { return mapping != nullptr; }
+    std::size_t size() const noexcept { return entries; }
+
+    // A legal book move for `pos`, drawn with probability proportional to its weight, or
+    // Move::NONE() if the position is not in the book or all its moves have zero weight.
+    Move probe(const PositionState& pos, Utility::PRNG& rng) const;
+
+    // The position's key in Polyglot's hashing scheme, which is unrelated to PositionState::key().
+    static std::uint64_t polyglot_key(const PositionState& pos) noexcept;
+
+   private:
+    struct Entry {
+        std::uint64_t key;
+        std::uint16_t move;
+        std::uint16_t weight;
+    };
+
+    Entry       entry(std::size_t index) const noexcept;
+    static Move decode(const PositionState& pos, std::uint16_t move);
+
+    void*       mapping      = nullptr;
+    std::size_t mapping_size = 0;
+    std::size_t entries      = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef VOLTA_CASTLING_HPP__
+#define VOLTA_CASTLING_HPP__
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "bitboard.hpp"
+#include "common.hpp"
+#include "coordinates.hpp"
+#include "utility.hpp"
+
+namespace Volta::Chess {
+
+// The four castling rights as a 4-bit mask.
+class CastlingRights {
+   private:
+    enum class underlying : std::uint8_t {
+        NONE            = 0b0000,
+        WHITE_KINGSIDE  = 0b0001,
+        WHITE_QUEENSIDE = 0b0010,
+        BLACK_KINGSIDE  = 0b0100,
+        BLACK_QUEENSIDE = 0b1000,
+        ALL             = 0b1111
+    };
+
+    constexpr CastlingRights(underlying cr) :
+        castling_rights{cr} {}
+
+    underlying castling_rights;
+
+   public:
+    using underlying_type_t = std::underlying_type_t<underlying>;
+
+    constexpr CastlingRights() :
+        castling_rights{underlying::NONE} {}
+
+    constexpr auto to_underlying() const noexcept { return Utility::to_underlying(castling_rights); }
+
+    static constexpr CastlingRights from_ordinal(auto ordinal) noexcept {
+        return static_cast<underlying>(ordinal);
+    }
+
+    static constexpr CastlingRights NONE() noexcept { return underlying::NONE; }
+    static constexpr CastlingRights WHITE_KINGSIDE() noexcept { return underlying::WHITE_KINGSIDE; }
+    static constexpr CastlingRights WHITE_QUEENSIDE() noexcept {
+        return underlying::WHITE_QUEENSIDE;
+    }
+    static constexpr CastlingRights BLACK_KINGSIDE() noexcept { return underlying::BLACK_KINGSIDE; }
+    static constexpr CastlingRights BLACK_QUEENSIDE() noexcept {
+        return underlying::BLACK_QUEENSIDE;
+    }
+    static constexpr CastlingRights ALL() noexcept { return underlying::ALL; }
+
+    // Number of distinct masks, not of individual rights.
+    static constexpr std::size_t COUNT() noexcept { return 16; }
+
+    static constexpr CastlingRights from_color(const Color color) noexcept {
+        return color == Color::WHITE() ? from_ordinal(0b0011) : from_ordinal(0b1100);
+    }
+
+    // Parses the castling field of a FEN, e.g. "KQkq" or "-".
+    static constexpr CastlingRights from_string(std::string_view str) noexcept {
+        CastlingRights ret = NONE();
+
+        for (const char ch : str)
+        {
+            switch (ch)
+            {
+            case 'K' :
+                ret |= WHITE_KINGSIDE();
+                break;
+            case 'Q' :
+                ret |= WHITE_QUEENSIDE();
+                break;
+            case 'k' :
+                ret |= BLACK_KINGSIDE();
+                break;
+            case 'q' :
+                ret |= BLACK_QUEENSIDE();
+                break;
+            default :
+                break;
+            }
+        }
+
+        return ret;
+    }
+
+    constexpr bool operator==(const CastlingRights& other) const noexcept {
+        return castling_rights == other.castling_rights;
+    }
+
+    constexpr explicit operator bool() const noexcept { return to_underlying() != 0; }
+
+    constexpr CastlingRights operator|(const CastlingRights rhs) const noexcept {
+        return from_ordinal(to_underlying() | rhs.to_underlying());
+    }
+
+    constexpr CastlingRights operator&(const CastlingRights rhs) const noexcept {
+        return from_ordinal(to_underlying() & rhs.to_underlying());
+    }
+
+    constexpr CastlingRights operator~() const noexcept {
+        return from_ordinal(~to_underlying() & ALL().to_underlying());
+    }
+
+    constexpr CastlingRights& operator|=(const CastlingRights rhs) noexcept {
+        return *this = *this | rhs;
+    }
+
+    constexpr CastlingRights& operator&=(const CastlingRights rhs) noexcept {
+        return *this = *this & rhs;
+    }
+};
+
+namespace Detail {
+
+// Squares a castle moves through. `empty` must hold no pieces besides the king and rook, and no
+// square in `safe` (the king's start, transit and destination) may be attacked.
+struct CastlingPath {
+    CastlingRights right;
+    Square         king_from;
+    Square         king_to;
+    Square         rook_from;
+    Square         rook_to;
+    BitBoard       empty;
+    BitBoard       safe;
+};
+
+consteval BitBoard squares_between_files(const Rank rank, const File first, const File last) {
+    BitBoard bb{};
+
+    for (auto file = first.to_underlying(); file <= last.to_underlying(); file++)
+        bb |= Square(File::from_ordinal(file), rank).to_bb();
+
+    return bb;
+}
+
+consteval CastlingPath
+make_castling_path(const CastlingRights right, const Rank rank, const bool kingside) {
+    const File king_to   = kingside ? File::FILE_G() : File::FILE_C();
+    const File rook_from = kingside ? File::FILE_H() : File::FILE_A();
+    const File rook_to   = kingside ? File::FILE_F() : File::FILE_D();
+
+    return {.right     = right,
+            .king_from = Square(File::FILE_E(), rank),
+            .king_to   = Square(king_to, rank),
+            .rook_from = Square(rook_from, rank),
+            .rook_to   = Square(rook_to, rank),
+            .empty     = kingside ? squares_between_files(rank, File::FILE_F(), File::FILE_G())
+                                  : squares_between_files(rank, File::FILE_B(), File::FILE_D()),
+            .safe      = kingside ? squares_between_files(rank, File::FILE_E(), File::FILE_G())
+                                  : squares_between_files(rank, File::FILE_C(), File::FILE_E())};
+}
+
+// Rights that survive a move touching each square: moving from or capturing on a king or rook
+// home square clears the rights that depend on it.
+consteval std::array<CastlingRights, Square::COUNT()> generate_castling_rights_masks() {
+    std::array<CastlingRights, Square::COUNT()> masks{};
+
+    for (auto& mask : masks)
+        mask = CastlingRights::ALL();
+
+    const auto clear = [&masks](const File file, const Rank rank, const CastlingRights rights) {
+        masks[Square(file, rank).ordinal()] &= ~rights;
+    };
+
+    clear(File::FILE_E(), Rank::RANK_1(), CastlingRights::from_color(Color::WHITE()));
+    clear(File::FILE_H(), Rank::RANK_1(), CastlingRights::WHITE_KINGSIDE());
+    clear(File::FILE_A(), Rank::RANK_1(), CastlingRights::WHITE_QUEENSIDE());
+    clear(File::FILE_E(), Rank::RANK_8(), CastlingRights::from_color(Color::BLACK()));
+    clear(File::FILE_H(), Rank::RANK_8(), CastlingRights::BLACK_KINGSIDE());
+    clear(File::FILE_A(), Rank::RANK_8(), CastlingRights::BLACK_QUEENSIDE());
+
+    return masks;
+}
+
+}
+
+class Castling {
+   private:
+    using PathsPerColor = std::array<Detail::CastlingPath, 2>;
+
+    static constexpr std::array<PathsPerColor, Color::COUNT()> Paths = {
+      PathsPerColor{
+        Detail::make_castling_path(CastlingRights::WHITE_KINGSIDE(), Rank::RANK_1(), true),
+        Detail::make_castling_path(CastlingRights::WHITE_QUEENSIDE(), Rank::RANK_1(), false)},
+      PathsPerColor{
+        Detail::make_castling_path(CastlingRights::BLACK_KINGSIDE(), Rank::RANK_8(), true),
+        Detail::make_castling_path(CastlingRights::BLACK_QUEENSIDE(), Rank::RANK_8(), false)}};
+
+    static constexpr std::array<CastlingRights, Square::COUNT()> RightsMasks =
+      Detail::generate_castling_rights_masks();
+
+   public:
+    // The kingside and queenside castles of one color.
+    static constexpr const PathsPerColor& paths(const Color color) noexcept {
+        return Paths[color.to_underlying()];
+    }
+
+    // Castling moves are encoded as king moves, so the king's destination identifies the castle.
+    static constexpr const Detail::CastlingPath& path(const Color color, const Square king_to) {
+        return paths(color)[paths(color)[0].king_to == king_to ? 0 : 1];
+    }
+
+    static constexpr CastlingRights rights_mask(const Square sq) noexcept {
+        return RightsMasks[sq.ordinal()];
+    }
+};
+
+}
+
+#endif
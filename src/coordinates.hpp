@@ -170,6 +170,8 @@ class Square {
     constexpr BitBoard to_bb() const noexcept { return 1ULL << ordinal(); }
     constexpr bool     is_valid() const noexcept { return square != underlying::None; }
 
+    constexpr bool operator==(const Square& other) const noexcept { return square == other.square; }
+
     static constexpr Square NONE() noexcept { return underlying::None; }
 
     static constexpr std::size_t COUNT() noexcept { return 64; }
@@ -0,0 +1,42 @@
+#include "evaluate.hpp"
+
+#include <algorithm>
+
+#include "bbmanip.hpp"
+#include "psqt.hpp"
+
+namespace Volta::Engine {
+
+namespace {
+
+// Per friendly pawn on the king's file or an adjacent one, one and two ranks in front of the king.
+constexpr std::array<Score, 2> SHELTER = {Chess::Detail::S(15, 0), Chess::Detail::S(8, 0)};
+
+// Depends on the king square as well as the pawns, so it stays out of the pawn table.
+Score shelter(const PositionState& pos, const Color color) {
+    const Direction up    = color == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
+    const BitBoard  king  = pos.king_square(color).to_bb();
+    const BitBoard  pawns = pos.bb(Piece::make(PieceType::PAWN(), color));
+    const BitBoard  near  =
+      shift(king | shift(king, Direction::EAST()) | shift(king, Direction::WEST()), up);
+
+    return SHELTER[0] * (pawns & near).popcount()
+         + SHELTER[1] * (pawns & shift(near, up)).popcount();
+}
+
+}  // namespace
+
+// Material and piece-square terms are maintained incrementally by the position and pawn structure
+// comes from the pawn table, so this mostly interpolates between midgame and endgame halves by the
+// remaining material.
+Value evaluate(const PositionState& pos, PawnTable& pawns) {
+    const Score        score = pos.psqt() + pawns.probe(pos).score + shelter(pos, Color::WHITE())
+                             - shelter(pos, Color::BLACK());
+    const std::int32_t phase = std::min(pos.phase(), Psqt::MAX_PHASE());
+    const Value        value =
+      (score.mg() * phase + score.eg() * (Psqt::MAX_PHASE() - phase)) / Psqt::MAX_PHASE();
+
+    return pos.stm() == Color::WHITE() ? value : -value;
+}
+
+}
@@ -0,0 +1,29 @@
+#ifndef VOLTA_EVALUATE_HPP__
+#define VOLTA_EVALUATE_HPP__
+
+#include <array>
+#include <cstdint>
+
+#include "pawns.hpp"
+#include "piece.hpp"
+#include "position.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+using Value = std::int32_t;
+
+inline constexpr std::array<Value, PieceType::COUNT()> PieceValues = {100, 320, 330, 500, 900, 0};
+
+constexpr Value piece_value(const PieceType piece_type) {
+    return PieceValues[piece_type.to_underlying()];
+}
+
+// Static evaluation in centipawns from the side to move's point of view. Pawn structure is looked
+// up in, and if need be added to, the calling thread's `pawns`.
+Value evaluate(const PositionState& pos, PawnTable& pawns);
+
+}
+
+#endif
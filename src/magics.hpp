@@ -1,6 +1,11 @@
 #ifndef VOLTA_MAGICS_HPP__
 #define VOLTA_MAGICS_HPP__
 
+#include <array>
+#include <cstdint>
+
+#include "coordinates.hpp"
+
 namespace Volta::Chess {
 
 namespace Detail {
@@ -9,6 +14,58 @@ struct MagicEntry;
 
 }
 
+// Magic multipliers found by find_bishop_magic and find_rook_magic, indexed by square. They are
+// baked in so that no search runs at startup; regenerate them with `make magics`.
+// clang-format off
+inline constexpr std::array<std::uint64_t, Square::COUNT()> BishopMagicNumbers = {
+  0x0808431002060060ULL, 0x0010420214086902ULL, 0x0004211401000114ULL,
+  0x02060a1200005290ULL, 0x8012021000400000ULL, 0x0801015840800080ULL,
+  0x0004120804044500ULL, 0x0501040184240604ULL, 0x0a00682310020601ULL,
+  0x4001041002004901ULL, 0x6804500102002464ULL, 0x4800022082014400ULL,
+  0x00000a0210800008ULL, 0x0280c088044041b0ULL, 0x84000044100c1080ULL,
+  0x24101888c8021002ULL, 0x2008080451540810ULL, 0x0004080801080208ULL,
+  0xc0021a4400620200ULL, 0x0098000082004400ULL, 0x800e10c401040400ULL,
+  0x0420400809101021ULL, 0x0052000101901401ULL, 0x2001820032011000ULL,
+  0x0002109662604a03ULL, 0x0738580002100104ULL, 0x04030400018c0400ULL,
+  0x0001802108020020ULL, 0x0089001021014000ULL, 0x4000820001010080ULL,
+  0x880401406c064200ULL, 0x100202000c84c14dULL, 0x0021211080200400ULL,
+  0x0108041010020200ULL, 0x000c004800011200ULL, 0x0280401048060200ULL,
+  0x0102008400220020ULL, 0x4022080200004050ULL, 0x0122008401050402ULL,
+  0x0014040150812100ULL, 0x0582020240212000ULL, 0x0218a80402031000ULL,
+  0x0101420041001020ULL, 0x0020902024200800ULL, 0x0800401093021202ULL,
+  0x00a2100202020020ULL, 0x1120640421408080ULL, 0x00888084008054c8ULL,
+  0x0004120804044500ULL, 0x1240908090102005ULL, 0x8000226884100400ULL,
+  0x0880008042020000ULL, 0x2000040410442040ULL, 0x041010200169002aULL,
+  0x0808431002060060ULL, 0x0010420214086902ULL, 0x0501040184240604ULL,
+  0x24101888c8021002ULL, 0x6003250104431002ULL, 0x8012a0040c208801ULL,
+  0x0108041010020200ULL, 0x0400000420440100ULL, 0x0a00682310020601ULL,
+  0x0808431002060060ULL};
+
+inline constexpr std::array<std::uint64_t, Square::COUNT()> RookMagicNumbers = {
+  0x0080004008811020ULL, 0x4840004020021009ULL, 0x5900130060004028ULL,
+  0xa480100080050801ULL, 0x1900100800050002ULL, 0xa400a00802040010ULL,
+  0x4100010020920024ULL, 0x1080002100005c80ULL, 0x0002800840028020ULL,
+  0x0000402000401000ULL, 0x0000808010002000ULL, 0x202200401a011020ULL,
+  0x0021001048010204ULL, 0x0001000844004300ULL, 0x0201000402000100ULL,
+  0x0c01800100004080ULL, 0x001c808004400220ULL, 0x0060810021024001ULL,
+  0x0020030040102101ULL, 0x0040808010030800ULL, 0x0078008048240080ULL,
+  0x400301001c004618ULL, 0x6400040006300108ULL, 0x00000a0000440081ULL,
+  0x0084400080028022ULL, 0x11005000c0002001ULL, 0x2410001080200080ULL,
+  0x00010029001000a4ULL, 0x8008080080040080ULL, 0x0402008080140026ULL,
+  0x00080c0101000200ULL, 0x6800006600010884ULL, 0x400840042080008aULL,
+  0x2081a00080804008ULL, 0x0400504105002000ULL, 0x4022214202001048ULL,
+  0x0281800402800801ULL, 0x0002804401800600ULL, 0x0200b0018c000248ULL,
+  0x0800010062000094ULL, 0x0084400080028022ULL, 0x0001600050014000ULL,
+  0x400200c0208a0010ULL, 0x400200c0208a0010ULL, 0x0002006810060020ULL,
+  0x10860008101a0005ULL, 0x1482980302040050ULL, 0x000ca41680420001ULL,
+  0x8002409600630200ULL, 0x8002409600630200ULL, 0x2280460410208200ULL,
+  0x0010608810010100ULL, 0x8008080080040080ULL, 0x0001000844004300ULL,
+  0x0201000402000100ULL, 0x4080008244051600ULL, 0x0020210041108005ULL,
+  0x8009400021001281ULL, 0x0100a230802a00c2ULL, 0x11c2004008200432ULL,
+  0x402100020410c801ULL, 0x0112001001082452ULL, 0x6802101148820804ULL,
+  0x9028840023811042ULL};
+// clang-format on
+
 Detail::MagicEntry find_bishop_magic(const Square sq);
 Detail::MagicEntry find_rook_magic(const Square sq);
 
@@ -1,44 +1,193 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <vector>
 
-#include "attacks.hpp"
 #include "perft.hpp"
-#include "piece.hpp"
 #include "position.hpp"
-#include "movegen.hpp"
+#include "search.hpp"
+#include "threadpool.hpp"
+#include "tt.hpp"
 #include "uci.hpp"
 
-int main() {
+namespace {
+
+constexpr std::string_view PERFT_USAGE =
+  "usage: volta perft <depth> [--threads N] [--split D] [--hash MB] [--policy copy|unmake] "
+  "[--fen \"<fen>\"]";
+
+// Positions for the lazy SMP time-to-depth report.
+const std::vector<std::string_view> SmpPositions = {
+  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+  "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+  "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+  "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+  "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"};
+
+// Single-threaded, unhashed count with an explicit child policy, for comparing copy-make against
+// make/unmake.
+template<typename Policy>
+void timed_perft(const Volta::Chess::PositionState& pos, std::int32_t depth) {
+    const auto          start = std::chrono::steady_clock::now();
+    const std::uint64_t nodes = Volta::Chess::perft<Policy>(pos, depth);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Nodes searched: " << nodes << "\n";
+    std::cout << "Time: " << elapsed.count() << " s, "
+              << static_cast<std::uint64_t>(nodes / elapsed.count()) << " nps" << std::endl;
+}
+
+// volta perft <depth> [--threads N] [--split D] [--hash MB] [--policy copy|unmake] [--fen "<fen>"]
+int run_perft(const std::vector<std::string_view>& args) {
     using namespace Volta::Chess;
+
+    if (args.empty())
+    {
+        std::cerr << PERFT_USAGE << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::int32_t depth       = std::stoi(std::string(args[0]));
+    std::size_t        threads     = 1;
+    std::int32_t       split_depth = 2;
+    std::size_t        hash_mb     = 0;
+    std::string_view   policy      = {};
+    PositionState      pos         = PositionState::startpos();
+
+    for (std::size_t i = 1; i + 1 < args.size(); i += 2)
+    {
+        if (args[i] == "--threads")
+            threads = std::stoul(std::string(args[i + 1]));
+        else if (args[i] == "--split")
+            split_depth = std::stoi(std::string(args[i + 1]));
+        else if (args[i] == "--hash")
+            hash_mb = std::stoul(std::string(args[i + 1]));
+        else if (args[i] == "--policy")
+            policy = args[i + 1];
+        else if (args[i] == "--fen")
+            pos = PositionState::from_fen(args[i + 1]);
+    }
+
+    // The work-stealing pool needs at least one worker.
+    if (threads == 0)
+    {
+        std::cerr << PERFT_USAGE << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (policy == "copy")
+    {
+        timed_perft<CopyMake>(pos, depth);
+        return EXIT_SUCCESS;
+    }
+
+    if (policy == "unmake")
+    {
+        timed_perft<MakeUnmake>(pos, depth);
+        return EXIT_SUCCESS;
+    }
+
+    if (!policy.empty())
+    {
+        std::cerr << PERFT_USAGE << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<PerftTable> table;
+    if (hash_mb > 0)
+        table = std::make_unique<PerftTable>(hash_mb);
+
+    parallel_split_perft(pos, depth, threads, split_depth, table.get());
+    return EXIT_SUCCESS;
+}
+
+// volta smp [--depth N] [--max-threads N] [--hash MB]
+//
+// Searches every SMP position to a fixed depth with 1, 2, 4, ... threads, each from a cleared
+// table, and prints the total time to depth and the speedup over one thread. Real speedups need as
+// many idle cores as threads.
+int run_smp(const std::vector<std::string_view>& args) {
     using namespace Volta::Engine;
 
-    Attacks::init_magics();
+    std::int32_t depth       = 7;
+    std::size_t  max_threads = 32;
+    std::size_t  hash_mb     = 64;
+
+    for (std::size_t i = 0; i + 1 < args.size(); i += 2)
+    {
+        if (args[i] == "--depth")
+            depth = std::stoi(std::string(args[i + 1]));
+        else if (args[i] == "--max-threads")
+            max_threads = std::stoul(std::string(args[i + 1]));
+        else if (args[i] == "--hash")
+            hash_mb = std::stoul(std::string(args[i + 1]));
+    }
+
+    TranspositionTable tt{hash_mb};
+    SearchLimits       limits;
+    std::atomic<bool>  stop{false};
+    double             baseline = 0.0;
+
+    limits.depth = depth;
+
+    std::printf("%7s %10s %8s %14s %12s\n", "threads", "time (s)", "speedup", "nodes", "nps");
 
-    MoveList      movelist{};
-    PositionState pos = PositionState::startpos();
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        std::unique_ptr<Volta::Utility::ThreadPool> helpers;
+        if (threads > 1)
+            helpers = std::make_unique<Volta::Utility::ThreadPool>(threads - 1);
 
-    // std::cout << int(pos.stm().to_underlying()) << std::endl;
+        std::uint64_t nodes   = 0;
+        double        seconds = 0.0;
 
-    // append_all_moves(movelist, pos);
+        for (const std::string_view fen : SmpPositions)
+        {
+            const PositionState pos = PositionState::from_fen(fen);
+            tt.clear(threads);
 
-    // for (const Move move : movelist)
-    //     std::cout << move.to_uci() << std::endl;
+            std::vector<std::unique_ptr<ThreadData>> thread_data;
 
-    // for (const Move move : movelist)
-    // {
-    //     PositionState newPos = pos;
-    //     newPos.make_move(move);
-    //     std::cout << newPos << std::endl;
-    // }
+            const auto         start  = std::chrono::steady_clock::now();
+            const SearchResult result =
+              search(pos, {}, limits, stop, tt, nullptr, helpers.get(), thread_data, false);
 
-    // std::cout << perft(pos, 5) << std::endl;
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            nodes += result.nodes;
+            seconds += elapsed.count();
+        }
+
+        if (threads == 1)
+            baseline = seconds;
+
+        std::printf("%7zu %10.3f %8.2f %14llu %12llu\n", threads, seconds, baseline / seconds,
+                    static_cast<unsigned long long>(nodes),
+                    static_cast<unsigned long long>(nodes / seconds));
+        std::fflush(stdout);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+}
 
-    pos =
-      PositionState::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w - - 0 1");
+int main(int argc, char* argv[]) {
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
 
-    // Move move = move_from_uci(pos, "g2g1n");
+    if (!args.empty() && args[0] == "perft")
+        return run_perft({args.begin() + 1, args.end()});
 
-    // pos.make_move(move);
+    if (!args.empty() && args[0] == "smp")
+        return run_smp({args.begin() + 1, args.end()});
 
-    split_perft(pos, 5);
+    Volta::Engine::Uci uci;
+    uci.loop();
+    return EXIT_SUCCESS;
 }
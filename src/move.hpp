@@ -2,6 +2,8 @@
 #define VOLTA_MOVE_HPP__
 
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "coordinates.hpp"
@@ -118,6 +120,8 @@ class Move {
     constexpr Square from() const noexcept { return Square::from_ordinal((move >> 6) & 0b111111); }
     constexpr MoveFlag flag() const noexcept { return MoveFlag::from_ordinal(move >> 12); }
 
+    constexpr bool operator==(const Move& other) const noexcept = default;
+
     constexpr bool      is_normal() const noexcept { return flag().is_normal(); }
     constexpr bool      is_ep() const noexcept { return flag().is_ep(); }
     constexpr bool      is_capture() const noexcept { return flag().is_capture(); }
@@ -125,13 +129,21 @@ class Move {
     constexpr bool      is_castling() const noexcept { return flag().is_castling(); }
     constexpr PieceType promtion_piece() const noexcept { return flag().get_promtion_piecetype(); }
 
-    constexpr std::string to_uci() const noexcept {
-        std::string ret = std::string(from()) + std::string(to());
+    // Writes the move in UCI notation ("e2e4", "e7e8q") into `buffer` and returns a view of it.
+    constexpr std::string_view to_uci(char (&buffer)[6]) const noexcept {
+        buffer[0] = static_cast<char>('a' + from().file().to_underlying());
+        buffer[1] = static_cast<char>('1' + from().rank().to_underlying());
+        buffer[2] = static_cast<char>('a' + to().file().to_underlying());
+        buffer[3] = static_cast<char>('1' + to().rank().to_underlying());
+        buffer[4] = is_promotion() ? promtion_piece().to_char() : '\0';
+        buffer[5] = '\0';
 
-        if (is_promotion())
-            ret += promtion_piece().to_char();
+        return {buffer, is_promotion() ? 5U : 4U};
+    }
 
-        return ret;
+    std::string to_uci() const {
+        char buffer[6];
+        return std::string(to_uci(buffer));
     }
 
     static constexpr Move NONE() {
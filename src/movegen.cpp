@@ -2,6 +2,7 @@
 
 #include "attacks.hpp"
 #include "bitboard.hpp"
+#include "castling.hpp"
 #include "common.hpp"
 #include "move.hpp"
 #include "piece.hpp"
@@ -10,31 +11,198 @@ namespace Volta::Chess {
 
 namespace {
 
+// Restrictions applied on top of pseudo-legal generation. Pieces other than the king may only
+// move to `target`, and a pinned piece additionally has to stay on the line through its king.
+// `captures` covers captures, en passant and every promotion; `quiets` covers all other moves.
+struct MoveMasks {
+    Square   ksq;
+    BitBoard checkers;
+    BitBoard pinned;
+    BitBoard target;
+    bool     legal;
+    bool     captures;
+    bool     quiets;
+};
+
+MoveMasks pseudo_legal_masks(const PositionState& pos, const bool captures, const bool quiets);
+MoveMasks legal_masks(const PositionState& pos);
+
+void append_moves(MoveList& movelist, const PositionState& pos, const MoveMasks& masks);
+
 void append_moves_from_sq_to_bb(MoveList&      movelist,
                                 const Square   from,
                                 BitBoard       bb,
                                 const MoveFlag flag);
-
-void append_pawn_moves(MoveList& movelist, const PositionState& pos);
-void append_knight_moves(MoveList& movelist, const PositionState& pos);
-void append_bishop_moves(MoveList& movelist, const PositionState& pos);
-void append_rook_moves(MoveList& movelist, const PositionState& pos);
-void append_queen_moves(MoveList& movelist, const PositionState& pos);
-void append_king_moves(MoveList& movelist, const PositionState& pos);
+void append_piece_targets(MoveList&            movelist,
+                          const PositionState& pos,
+                          const Square         from,
+                          const BitBoard       targets,
+                          const MoveMasks&     masks);
+void append_promotions(MoveList& movelist, const Square from, const Square to, const MoveFlag flag);
+
+void append_pawn_moves(MoveList& movelist, const PositionState& pos, const MoveMasks& masks);
+void append_pawn_moves_to(MoveList&            movelist,
+                          const PositionState& pos,
+                          const BitBoard       pawn_bb,
+                          const BitBoard       target,
+                          const MoveMasks&     masks);
+void append_en_passant(MoveList& movelist, const PositionState& pos, const BitBoard pawn_bb);
+void append_king_moves(MoveList& movelist, const PositionState& pos, const MoveMasks& masks);
+void append_castling(MoveList& movelist, const PositionState& pos);
+
+template<typename Function>
+void append_piece_moves(MoveList&            movelist,
+                        const PositionState& pos,
+                        const PieceType      piece_type,
+                        const MoveMasks&     masks,
+                        Function&&           attacks_fn);
+
+std::size_t
+count_pawn_moves(const PositionState& pos, const BitBoard pawn_bb, const BitBoard target);
+
+template<typename Function>
+std::size_t count_piece_moves(const PositionState& pos,
+                              const PieceType      piece_type,
+                              const MoveMasks&     masks,
+                              Function&&           attacks_fn);
+
+BitBoard knight_attacks(const Square sq, const BitBoard) { return Attacks::knight_attacks(sq); }
 
 }  // namespace
 
 void append_all_moves(MoveList& movelist, const PositionState& pos) {
-    append_pawn_moves(movelist, pos);
-    append_knight_moves(movelist, pos);
-    append_bishop_moves(movelist, pos);
-    append_rook_moves(movelist, pos);
-    append_queen_moves(movelist, pos);
-    append_king_moves(movelist, pos);
+    append_moves(movelist, pos, pseudo_legal_masks(pos, true, true));
+}
+
+void append_captures(MoveList& movelist, const PositionState& pos) {
+    append_moves(movelist, pos, pseudo_legal_masks(pos, true, false));
+}
+
+void append_quiets(MoveList& movelist, const PositionState& pos) {
+    append_moves(movelist, pos, pseudo_legal_masks(pos, false, true));
+}
+
+void append_evasions(MoveList& movelist, const PositionState& pos) {
+    const MoveMasks masks = legal_masks(pos);
+
+    assert(masks.checkers);
+
+    append_moves(movelist, pos, masks);
+}
+
+void append_legal_moves(MoveList& movelist, const PositionState& pos) {
+    append_moves(movelist, pos, legal_masks(pos));
+}
+
+std::size_t count_legal_moves(const PositionState& pos) {
+    const MoveMasks masks = legal_masks(pos);
+    const BitBoard  occ   = pos.bb(Color::WHITE(), Color::BLACK());
+    const BitBoard  them  = pos.bb(~pos.stm());
+
+    std::size_t count = 0;
+
+    {
+        BitBoard targets = Attacks::king_attacks(masks.ksq) & ~pos.bb(pos.stm());
+        while (targets)
+        {
+            const Square to = Square::from_ordinal(targets.pop_lsb());
+            if (!(pos.attackers_to(to, occ ^ masks.ksq.to_bb()) & them))
+                count++;
+        }
+    }
+
+    if (masks.checkers.popcount() > 1)
+        return count;
+
+    if (!masks.checkers && (pos.castling_rights() & CastlingRights::from_color(pos.stm())))
+    {
+        for (const Detail::CastlingPath& path : Castling::paths(pos.stm()))
+            if (pos.can_castle(path))
+                count++;
+    }
+
+    const BitBoard pawns = pos.bb(pos.stm()) & pos.bb(PieceType::PAWN());
+
+    count += count_pawn_moves(pos, pawns & ~masks.pinned, masks.target);
+
+    {
+        BitBoard pinned_pawns = pawns & masks.pinned;
+        while (pinned_pawns)
+        {
+            const Square from = Square::from_ordinal(pinned_pawns.pop_lsb());
+            count += count_pawn_moves(pos, from.to_bb(),
+                                      masks.target & Attacks::line(masks.ksq, from));
+        }
+    }
+
+    // En passant can uncover a check along the rank of both pawns, so it is tested directly.
+    if (pos.en_passant_destination().is_valid())
+    {
+        MoveList ep_moves;
+        append_en_passant(ep_moves, pos, pawns);
+
+        for (const Move move : ep_moves)
+            if (pos.is_legal(move))
+                count++;
+    }
+
+    count += count_piece_moves(pos, PieceType::KNIGHT(), masks, knight_attacks);
+    count += count_piece_moves(pos, PieceType::BISHOP(), masks, Attacks::bishop_attacks);
+    count += count_piece_moves(pos, PieceType::ROOK(), masks, Attacks::rook_attacks);
+    count += count_piece_moves(pos, PieceType::QUEEN(), masks, Attacks::queen_attacks);
+
+    return count;
 }
 
 namespace {
 
+void append_moves(MoveList& movelist, const PositionState& pos, const MoveMasks& masks) {
+    // In double check only the king can move.
+    if (masks.checkers.popcount() < 2)
+    {
+        append_pawn_moves(movelist, pos, masks);
+        append_piece_moves(movelist, pos, PieceType::KNIGHT(), masks, knight_attacks);
+        append_piece_moves(movelist, pos, PieceType::BISHOP(), masks, Attacks::bishop_attacks);
+        append_piece_moves(movelist, pos, PieceType::ROOK(), masks, Attacks::rook_attacks);
+        append_piece_moves(movelist, pos, PieceType::QUEEN(), masks, Attacks::queen_attacks);
+    }
+
+    append_king_moves(movelist, pos, masks);
+}
+
+MoveMasks pseudo_legal_masks(const PositionState& pos, const bool captures, const bool quiets) {
+    return {.ksq      = pos.king_square(pos.stm()),
+            .checkers = 0ULL,
+            .pinned   = 0ULL,
+            .target   = ~pos.bb(pos.stm()),
+            .legal    = false,
+            .captures = captures,
+            .quiets   = quiets};
+}
+
+MoveMasks legal_masks(const PositionState& pos) {
+    const Color    side   = pos.stm();
+    const BitBoard us_occ = pos.bb(side);
+    const Square   ksq    = pos.king_square(side);
+
+    MoveMasks masks{.ksq      = ksq,
+                    .checkers = pos.checkers(),
+                    .pinned   = pos.blockers_for_king(side) & us_occ,
+                    .target   = ~us_occ,
+                    .legal    = true,
+                    .captures = true,
+                    .quiets   = true};
+
+    // A single check can only be answered by capturing the checker or blocking its ray.
+    if (masks.checkers)
+    {
+        const Square checker = Square::from_ordinal(masks.checkers.lsb());
+        masks.target &= Attacks::between(ksq, checker) | masks.checkers;
+    }
+
+    return masks;
+}
+
 void append_moves_from_sq_to_bb(MoveList&      movelist,
                                 const Square   from,
                                 BitBoard       bb,
@@ -46,22 +214,78 @@ void append_moves_from_sq_to_bb(MoveList&      movelist,
     }
 }
 
-void append_pawn_moves(MoveList& movelist, const PositionState& pos) {
+// Splits the destinations of a non-pawn move into quiet moves and captures, keeping only the kinds
+// the masks ask for.
+void append_piece_targets(MoveList&            movelist,
+                          const PositionState& pos,
+                          const Square         from,
+                          const BitBoard       targets,
+                          const MoveMasks&     masks) {
+    const BitBoard them_occ = pos.bb(~pos.stm());
+
+    if (masks.quiets)
+        append_moves_from_sq_to_bb(movelist, from, targets & ~them_occ, MoveFlag::NORMAL());
+
+    if (masks.captures)
+        append_moves_from_sq_to_bb(movelist, from, targets & them_occ, MoveFlag::CAPTURE());
+}
+
+void append_promotions(MoveList& movelist, const Square from, const Square to, const MoveFlag flag) {
+    movelist.push_back(Move(MoveFlag::make_promotion(PieceType::KNIGHT()) | flag, from, to));
+    movelist.push_back(Move(MoveFlag::make_promotion(PieceType::BISHOP()) | flag, from, to));
+    movelist.push_back(Move(MoveFlag::make_promotion(PieceType::ROOK()) | flag, from, to));
+    movelist.push_back(Move(MoveFlag::make_promotion(PieceType::QUEEN()) | flag, from, to));
+}
+
+void append_pawn_moves(MoveList& movelist, const PositionState& pos, const MoveMasks& masks) {
+    const BitBoard pawn_bb = pos.bb(pos.stm()) & pos.bb(PieceType::PAWN());
+
+    append_pawn_moves_to(movelist, pos, pawn_bb & ~masks.pinned, masks.target, masks);
+
+    BitBoard pinned_pawns = pawn_bb & masks.pinned;
+    while (pinned_pawns)
+    {
+        const Square from = Square::from_ordinal(pinned_pawns.pop_lsb());
+        append_pawn_moves_to(movelist, pos, from.to_bb(),
+                             masks.target & Attacks::line(masks.ksq, from), masks);
+    }
+
+    if (!masks.captures)
+        return;
+
+    if (!masks.legal)
+    {
+        append_en_passant(movelist, pos, pawn_bb);
+        return;
+    }
+
+    MoveList ep_moves;
+    append_en_passant(ep_moves, pos, pawn_bb);
+
+    for (const Move move : ep_moves)
+        if (pos.is_legal(move))
+            movelist.push_back(move);
+}
+
+void append_pawn_moves_to(MoveList&            movelist,
+                          const PositionState& pos,
+                          const BitBoard       pawn_bb,
+                          const BitBoard       target,
+                          const MoveMasks&     masks) {
     const Color    side     = pos.stm();
     const BitBoard us_occ   = pos.bb(side);
     const BitBoard them_occ = pos.bb(~side);
     const BitBoard occ      = us_occ | them_occ;
 
-    const BitBoard pawn_bb        = pos.bb(PieceType::PAWN()) & us_occ;
     const BitBoard starting_rank  = side == Color::WHITE() ? Rank::RANK_2() : Rank::RANK_7();
     const BitBoard promotion_rank = side == Color::WHITE() ? Rank::RANK_8() : Rank::RANK_1();
-    const BitBoard starting_pawns = pawn_bb & starting_rank;
 
     const Direction push_dir = side == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
 
-    {
-        const BitBoard forward_push = shift(pawn_bb, push_dir) & ~occ;
+    const BitBoard forward_push = shift(pawn_bb, push_dir) & ~occ & target;
 
+    if (masks.quiets)
+    {
         {
             BitBoard forward_push_normal = forward_push & ~promotion_rank;
             while (forward_push_normal)
@@ -72,46 +296,32 @@ void append_pawn_moves(MoveList& movelist, const PositionState& pos) {
         }
 
         {
-            BitBoard forward_push_promotion = forward_push & promotion_rank;
-            while (forward_push_promotion)
+            BitBoard forward_double_push =
+              shift(shift(pawn_bb & starting_rank, push_dir) & ~occ, push_dir) & ~occ & target;
+            while (forward_double_push)
             {
-                const Square to = Square::from_ordinal(forward_push_promotion.pop_lsb());
-
-                movelist.push_back(Move(MoveFlag::make_promotion(PieceType::KNIGHT()),
-                                        shift(to, push_dir.reverse()), to));
-                movelist.push_back(Move(MoveFlag::make_promotion(PieceType::BISHOP()),
-                                        shift(to, push_dir.reverse()), to));
-                movelist.push_back(Move(MoveFlag::make_promotion(PieceType::ROOK()),
-                                        shift(to, push_dir.reverse()), to));
-                movelist.push_back(Move(MoveFlag::make_promotion(PieceType::QUEEN()),
-                                        shift(to, push_dir.reverse()), to));
+                const Square to = Square::from_ordinal(forward_double_push.pop_lsb());
+                movelist.push_back(
+                  Move(MoveFlag::NORMAL(), shift(to, push_dir.reverse(), push_dir.reverse()), to));
             }
         }
     }
 
+    if (!masks.captures)
+        return;
+
     {
-        BitBoard forward_double_push =
-          shift(shift(pawn_bb & starting_rank, push_dir) & ~occ, push_dir) & ~occ;
-        while (forward_double_push)
+        BitBoard forward_push_promotion = forward_push & promotion_rank;
+        while (forward_push_promotion)
         {
-            const Square to = Square::from_ordinal(forward_double_push.pop_lsb());
-            movelist.push_back(
-              Move(MoveFlag::NORMAL(), shift(to, push_dir.reverse(), push_dir.reverse()), to));
+            const Square to = Square::from_ordinal(forward_push_promotion.pop_lsb());
+            append_promotions(movelist, shift(to, push_dir.reverse()), to, MoveFlag::NORMAL());
         }
     }
 
-    const Square ep_dest = pos.en_passant_destination();
-
     {
-        const BitBoard attack_west  = shift(pawn_bb, push_dir, Direction::WEST());
-        const BitBoard capture_west = attack_west & them_occ;
-
-        if (ep_dest.to_bb() & attack_west)
-        {
-            movelist.push_back(Move(MoveFlag::EN_PASSANT(),
-                                    shift(ep_dest, push_dir.reverse(), Direction::EAST()),
-                                    ep_dest));
-        }
+        const BitBoard capture_west =
+          shift(pawn_bb, push_dir, Direction::WEST()) & them_occ & target;
 
         {
             BitBoard capture_west_normal = capture_west & ~promotion_rank;
@@ -128,33 +338,15 @@ void append_pawn_moves(MoveList& movelist, const PositionState& pos) {
             while (capture_west_promotion)
             {
                 const Square to = Square::from_ordinal(capture_west_promotion.pop_lsb());
-
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::KNIGHT()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::EAST()), to));
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::BISHOP()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::EAST()), to));
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::ROOK()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::EAST()), to));
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::QUEEN()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::EAST()), to));
+                append_promotions(movelist, shift(to, push_dir.reverse(), Direction::EAST()), to,
+                                  MoveFlag::CAPTURE());
             }
         }
     }
 
     {
-        const BitBoard attack_east  = shift(pawn_bb, push_dir, Direction::EAST());
-        const BitBoard capture_east = attack_east & them_occ;
-
-        if (ep_dest.to_bb() & attack_east)
-        {
-            movelist.push_back(Move(MoveFlag::EN_PASSANT(),
-                                    shift(ep_dest, push_dir.reverse(), Direction::WEST()),
-                                    ep_dest));
-        }
+        const BitBoard capture_east =
+          shift(pawn_bb, push_dir, Direction::EAST()) & them_occ & target;
 
         {
             BitBoard capture_east_normal = capture_east & ~promotion_rank;
@@ -171,107 +363,148 @@ void append_pawn_moves(MoveList& movelist, const PositionState& pos) {
             while (capture_east_promotion)
             {
                 const Square to = Square::from_ordinal(capture_east_promotion.pop_lsb());
-
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::KNIGHT()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::WEST()), to));
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::BISHOP()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::WEST()), to));
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::ROOK()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::WEST()), to));
-                movelist.push_back(
-                  Move(MoveFlag::make_promotion(PieceType::QUEEN()) | MoveFlag::CAPTURE(),
-                       shift(to, push_dir.reverse(), Direction::WEST()), to));
+                append_promotions(movelist, shift(to, push_dir.reverse(), Direction::WEST()), to,
+                                  MoveFlag::CAPTURE());
             }
         }
     }
 }
 
-void append_knight_moves(MoveList& movelist, const PositionState& pos) {
-    const Color    side     = pos.stm();
-    const BitBoard us_occ   = pos.bb(side);
-    const BitBoard them_occ = pos.bb(~side);
+void append_en_passant(MoveList& movelist, const PositionState& pos, const BitBoard pawn_bb) {
+    const Square ep_dest = pos.en_passant_destination();
 
-    BitBoard piece_bb = us_occ & pos.bb(PieceType::KNIGHT());
+    if (!ep_dest.is_valid())
+        return;
 
-    while (piece_bb)
+    const Direction push_dir =
+      pos.stm() == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
+
+    if (ep_dest.to_bb() & shift(pawn_bb, push_dir, Direction::WEST()))
     {
-        const Square   from    = Square::from_ordinal(piece_bb.pop_lsb());
-        const BitBoard attacks = Attacks::knight_attacks(from) & (~us_occ);
+        movelist.push_back(Move(MoveFlag::EN_PASSANT(),
+                                shift(ep_dest, push_dir.reverse(), Direction::EAST()), ep_dest));
+    }
 
-        append_moves_from_sq_to_bb(movelist, from, attacks & (~them_occ), MoveFlag::NORMAL());
-        append_moves_from_sq_to_bb(movelist, from, attacks & them_occ, MoveFlag::CAPTURE());
+    if (ep_dest.to_bb() & shift(pawn_bb, push_dir, Direction::EAST()))
+    {
+        movelist.push_back(Move(MoveFlag::EN_PASSANT(),
+                                shift(ep_dest, push_dir.reverse(), Direction::WEST()), ep_dest));
     }
 }
 
-void append_bishop_moves(MoveList& movelist, const PositionState& pos) {
+template<typename Function>
+void append_piece_moves(MoveList&            movelist,
+                        const PositionState& pos,
+                        const PieceType      piece_type,
+                        const MoveMasks&     masks,
+                        Function&&           attacks_fn) {
     const Color    side     = pos.stm();
     const BitBoard us_occ   = pos.bb(side);
     const BitBoard them_occ = pos.bb(~side);
 
-    BitBoard piece_bb = us_occ & pos.bb(PieceType::BISHOP());
+    BitBoard piece_bb = us_occ & pos.bb(piece_type);
 
     while (piece_bb)
     {
-        const Square   from    = Square::from_ordinal(piece_bb.pop_lsb());
-        const BitBoard attacks = Attacks::bishop_attacks(from, us_occ | them_occ) & (~us_occ);
+        const Square from    = Square::from_ordinal(piece_bb.pop_lsb());
+        BitBoard     attacks = attacks_fn(from, us_occ | them_occ) & masks.target;
 
-        append_moves_from_sq_to_bb(movelist, from, attacks & (~them_occ), MoveFlag::NORMAL());
-        append_moves_from_sq_to_bb(movelist, from, attacks & them_occ, MoveFlag::CAPTURE());
+        if (masks.pinned & from.to_bb())
+            attacks &= Attacks::line(masks.ksq, from);
+
+        append_piece_targets(movelist, pos, from, attacks, masks);
     }
 }
 
-void append_rook_moves(MoveList& movelist, const PositionState& pos) {
+void append_king_moves(MoveList& movelist, const PositionState& pos, const MoveMasks& masks) {
     const Color    side     = pos.stm();
     const BitBoard us_occ   = pos.bb(side);
     const BitBoard them_occ = pos.bb(~side);
+    const BitBoard occ      = us_occ | them_occ;
 
-    BitBoard piece_bb = us_occ & pos.bb(PieceType::ROOK());
+    const Square from    = masks.ksq;
+    BitBoard     attacks = Attacks::king_attacks(from) & (~us_occ);
 
-    while (piece_bb)
+    if (masks.legal)
     {
-        const Square   from    = Square::from_ordinal(piece_bb.pop_lsb());
-        const BitBoard attacks = Attacks::rook_attacks(from, us_occ | them_occ) & (~us_occ);
+        BitBoard candidates = attacks;
+        while (candidates)
+        {
+            const Square to = Square::from_ordinal(candidates.pop_lsb());
 
-        append_moves_from_sq_to_bb(movelist, from, attacks & (~them_occ), MoveFlag::NORMAL());
-        append_moves_from_sq_to_bb(movelist, from, attacks & them_occ, MoveFlag::CAPTURE());
+            // The king must not stay on the ray of a slider it is stepping away from.
+            if (pos.attackers_to(to, occ ^ from.to_bb()) & them_occ)
+                attacks.clear(to.ordinal());
+        }
     }
+
+    append_piece_targets(movelist, pos, from, attacks, masks);
+
+    if (masks.quiets && !masks.checkers)
+        append_castling(movelist, pos);
+}
+
+// Castles are quiet king moves. Both the pseudo-legal and the legal generator only emit castles
+// whose path is empty and unattacked.
+void append_castling(MoveList& movelist, const PositionState& pos) {
+    if (!(pos.castling_rights() & CastlingRights::from_color(pos.stm())))
+        return;
+
+    for (const Detail::CastlingPath& path : Castling::paths(pos.stm()))
+        if (pos.can_castle(path))
+            movelist.push_back(Move(MoveFlag::CASTLING(), path.king_from, path.king_to));
 }
 
-void append_queen_moves(MoveList& movelist, const PositionState& pos) {
+// Pushes and captures to `target` of pawns that are free to move, without en passant.
+std::size_t
+count_pawn_moves(const PositionState& pos, const BitBoard pawn_bb, const BitBoard target) {
     const Color    side     = pos.stm();
-    const BitBoard us_occ   = pos.bb(side);
     const BitBoard them_occ = pos.bb(~side);
+    const BitBoard occ      = pos.bb(side) | them_occ;
 
-    BitBoard piece_bb = us_occ & pos.bb(PieceType::QUEEN());
+    const BitBoard starting_rank  = side == Color::WHITE() ? Rank::RANK_2() : Rank::RANK_7();
+    const BitBoard promotion_rank = side == Color::WHITE() ? Rank::RANK_8() : Rank::RANK_1();
 
-    while (piece_bb)
-    {
-        const Square   from    = Square::from_ordinal(piece_bb.pop_lsb());
-        const BitBoard attacks = Attacks::queen_attacks(from, us_occ | them_occ) & (~us_occ);
+    const Direction push_dir = side == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
 
-        append_moves_from_sq_to_bb(movelist, from, attacks & (~them_occ), MoveFlag::NORMAL());
-        append_moves_from_sq_to_bb(movelist, from, attacks & them_occ, MoveFlag::CAPTURE());
-    }
+    const BitBoard forward_push = shift(pawn_bb, push_dir) & ~occ & target;
+    const BitBoard forward_double_push =
+      shift(shift(pawn_bb & starting_rank, push_dir) & ~occ, push_dir) & ~occ & target;
+
+    const BitBoard capture_west = shift(pawn_bb, push_dir, Direction::WEST()) & them_occ & target;
+    const BitBoard capture_east = shift(pawn_bb, push_dir, Direction::EAST()) & them_occ & target;
+
+    return (forward_push & ~promotion_rank).popcount()
+         + 4 * (forward_push & promotion_rank).popcount() + forward_double_push.popcount()
+         + (capture_west & ~promotion_rank).popcount()
+         + 4 * (capture_west & promotion_rank).popcount()
+         + (capture_east & ~promotion_rank).popcount()
+         + 4 * (capture_east & promotion_rank).popcount();
 }
 
-void append_king_moves(MoveList& movelist, const PositionState& pos) {
-    const Color    side     = pos.stm();
-    const BitBoard us_occ   = pos.bb(side);
-    const BitBoard them_occ = pos.bb(~side);
+template<typename Function>
+std::size_t count_piece_moves(const PositionState& pos,
+                              const PieceType      piece_type,
+                              const MoveMasks&     masks,
+                              Function&&           attacks_fn) {
+    const BitBoard us_occ = pos.bb(pos.stm());
+    const BitBoard occ    = us_occ | pos.bb(~pos.stm());
 
-    BitBoard piece_bb = us_occ & pos.bb(PieceType::KING());
+    BitBoard    piece_bb = us_occ & pos.bb(piece_type);
+    std::size_t count    = 0;
 
     while (piece_bb)
     {
-        const Square   from    = Square::from_ordinal(piece_bb.pop_lsb());
-        const BitBoard attacks = Attacks::king_attacks(from) & (~us_occ);
+        const Square from    = Square::from_ordinal(piece_bb.pop_lsb());
+        BitBoard     targets = attacks_fn(from, occ) & masks.target;
+
+        if (masks.pinned & from.to_bb())
+            targets &= Attacks::line(masks.ksq, from);
 
-        append_moves_from_sq_to_bb(movelist, from, attacks & (~them_occ), MoveFlag::NORMAL());
-        append_moves_from_sq_to_bb(movelist, from, attacks & them_occ, MoveFlag::CAPTURE());
+        count += targets.popcount();
     }
+
+    return count;
 }
 
 }  // namespace
@@ -9,8 +9,26 @@ namespace Volta::Chess {
 
 using MoveList = Utility::fixed_vector<Move, 350>;
 
+// Pseudo-legal moves: the mover's king may be left in check.
 void append_all_moves(MoveList& movelist, const PositionState& pos);
 
+// The pseudo-legal moves split into stages. Captures include en passant and every promotion, quiet
+// or not, so quiescence search sees them; quiets are everything else.
+void append_captures(MoveList& movelist, const PositionState& pos);
+void append_quiets(MoveList& movelist, const PositionState& pos);
+
+// Legal replies to a check. The side to move must be in check.
+void append_evasions(MoveList& movelist, const PositionState& pos);
+
+// Legal moves only. Checkers and pinned pieces come from the position and the check-evasion
+// target mask is computed once per call, so the moves can be played without a legality test
+// afterwards.
+void append_legal_moves(MoveList& movelist, const PositionState& pos);
+
+// Number of legal moves in the position, counted from target bitboards where possible instead of
+// materializing and playing every move.
+std::size_t count_legal_moves(const PositionState& pos);
+
 }
 
 #endif
@@ -0,0 +1,226 @@
+#include "movepick.hpp"
+
+#include <utility>
+
+namespace Volta::Engine {
+
+namespace {
+
+// Evasion captures go ahead of every evasion quiet, whatever its history.
+constexpr std::int32_t CAPTURE_SCORE = 1 << 20;
+
+// MVV-LVA for captures, the promoted piece's value for promotions.
+std::int32_t mvv_lva(const PositionState& pos, const Move move) {
+    std::int32_t score = 0;
+
+    if (move.is_capture())
+    {
+        const PieceType victim =
+          move.is_ep() ? PieceType::PAWN() : pos.piece_on(move.to()).type();
+
+        score += 16 * piece_value(victim) - piece_value(pos.piece_on(move.from()).type()) / 16;
+    }
+
+    if (move.is_promotion())
+        score += piece_value(move.promtion_piece());
+
+    return score;
+}
+
+}  // namespace
+
+MovePicker::MovePicker(const PositionState&                        position,
+                       const Move                                  tt,
+                       const std::array<Move, 2>&                  killer_moves,
+                       const Move                                  counter,
+                       const ButterflyHistory&                     butterfly,
+                       const std::array<const PieceToHistory*, 2>& continuation_tables,
+                       bool                                        in_check) :
+    pos{position},
+    history{&butterfly},
+    continuation{continuation_tables},
+    tt_move{tt != Move::NONE() && position.is_pseudo_legal(tt) ? tt : Move::NONE()},
+    killers{killer_moves},
+    counter_move{counter},
+    stage{in_check ? Stage::EVASION_TT_MOVE : Stage::TT_MOVE},
+    current{0},
+    current_bad{0} {
+    if (tt_move == Move::NONE())
+        stage = in_check ? Stage::GENERATE_EVASIONS : Stage::GENERATE_CAPTURES;
+}
+
+MovePicker::MovePicker(const PositionState& position) :
+    pos{position},
+    history{nullptr},
+    continuation{},
+    tt_move{Move::NONE()},
+    killers{Move::NONE(), Move::NONE()},
+    counter_move{Move::NONE()},
+    stage{Stage::QS_GENERATE_CAPTURES},
+    current{0},
+    current_bad{0} {}
+
+Move MovePicker::next() {
+    switch (stage)
+    {
+    case Stage::TT_MOVE :
+    case Stage::EVASION_TT_MOVE :
+        stage = stage == Stage::TT_MOVE ? Stage::GENERATE_CAPTURES : Stage::GENERATE_EVASIONS;
+        return tt_move;
+
+    case Stage::GENERATE_CAPTURES :
+    case Stage::QS_GENERATE_CAPTURES :
+        append_captures(moves, pos);
+        score_captures();
+        stage = stage == Stage::GENERATE_CAPTURES ? Stage::GOOD_CAPTURES : Stage::QS_CAPTURES;
+        return next();
+
+    case Stage::GOOD_CAPTURES :
+        while (current < moves.size())
+        {
+            const Move move = select_best();
+
+            if (move == tt_move)
+                continue;
+
+            if (pos.see_ge(move, 0))
+                return move;
+
+            bad_captures.push_back(move);
+        }
+
+        stage = Stage::KILLER_1;
+        return next();
+
+    case Stage::KILLER_1 :
+        stage = Stage::KILLER_2;
+        return usable_quiet(killers[0]) ? killers[0] : next();
+
+    case Stage::KILLER_2 :
+        stage = Stage::COUNTER_MOVE;
+        return killers[1] != killers[0] && usable_quiet(killers[1]) ? killers[1] : next();
+
+    case Stage::COUNTER_MOVE :
+        stage = Stage::GENERATE_QUIETS;
+        return counter_move != killers[0] && counter_move != killers[1]
+                   && usable_quiet(counter_move)
+                 ? counter_move
+                 : next();
+
+    // Quiets are appended behind the captures, which have all been handed out or set aside.
+    case Stage::GENERATE_QUIETS :
+        append_quiets(moves, pos);
+        score_quiets();
+        stage = Stage::QUIETS;
+        return next();
+
+    case Stage::QUIETS :
+        while (current < moves.size())
+        {
+            const Move move = select_best();
+
+            if (move != tt_move && !is_refutation(move))
+                return move;
+        }
+
+        stage = Stage::BAD_CAPTURES;
+        return next();
+
+    case Stage::BAD_CAPTURES :
+        if (current_bad < bad_captures.size())
+            return bad_captures[current_bad++];
+
+        stage = Stage::DONE;
+        return Move::NONE();
+
+    case Stage::GENERATE_EVASIONS :
+        append_evasions(moves, pos);
+        score_evasions();
+        stage = Stage::EVASIONS;
+        return next();
+
+    case Stage::EVASIONS :
+        while (current < moves.size())
+        {
+            const Move move = select_best();
+
+            if (move != tt_move)
+                return move;
+        }
+
+        stage = Stage::DONE;
+        return Move::NONE();
+
+    case Stage::QS_CAPTURES :
+        if (current < moves.size())
+            return select_best();
+
+        stage = Stage::DONE;
+        return Move::NONE();
+
+    case Stage::DONE :
+        return Move::NONE();
+    }
+
+    return Move::NONE();
+}
+
+bool MovePicker::is_refutation(const Move move) const noexcept {
+    return move == killers[0] || move == killers[1] || move == counter_move;
+}
+
+// Killers and counter moves come from other positions, so they have to be re-validated here.
+bool MovePicker::usable_quiet(const Move move) const noexcept {
+    return move != Move::NONE() && move != tt_move && is_quiet(move) && pos.is_pseudo_legal(move);
+}
+
+void MovePicker::score_captures() {
+    for (std::size_t i = 0; i < moves.size(); i++)
+        scores[i] = mvv_lva(pos, moves[i]);
+}
+
+void MovePicker::score_quiets() {
+    const std::size_t color = pos.stm().to_underlying();
+
+    for (std::size_t i = current; i < moves.size(); i++)
+    {
+        const Move        move  = moves[i];
+        const std::size_t piece = pos.piece_on(move.from()).to_underlying();
+        const std::size_t to    = move.to().ordinal();
+
+        scores[i] = (*history)[color][move.from().ordinal() * Square::COUNT() + to];
+
+        for (const PieceToHistory* table : continuation)
+            if (table)
+                scores[i] += (*table)[piece][to];
+    }
+}
+
+void MovePicker::score_evasions() {
+    const std::size_t color = pos.stm().to_underlying();
+
+    for (std::size_t i = 0; i < moves.size(); i++)
+    {
+        const Move        move = moves[i];
+        const std::size_t from = move.from().ordinal();
+
+        scores[i] = is_quiet(move) ? (*history)[color][from * Square::COUNT() + move.to().ordinal()]
+                                   : CAPTURE_SCORE + mvv_lva(pos, move);
+    }
+}
+
+// One step of selection sort: swaps the best remaining move to the front of the unsorted part.
+Move MovePicker::select_best() {
+    std::size_t best = current;
+
+    for (std::size_t i = current + 1; i < moves.size(); i++)
+        if (scores[i] > scores[best])
+            best = i;
+
+    std::swap(moves[best], moves[current]);
+    std::swap(scores[best], scores[current]);
+
+    return moves[current++];
+}
+
+}
@@ -0,0 +1,126 @@
+#ifndef VOLTA_MOVEPICK_HPP__
+#define VOLTA_MOVEPICK_HPP__
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+#include "common.hpp"
+#include "coordinates.hpp"
+#include "evaluate.hpp"
+#include "move.hpp"
+#include "movegen.hpp"
+#include "piece.hpp"
+#include "position.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+inline constexpr std::int32_t HISTORY_MAX = 16384;
+
+// A history score. Updates pull the value toward the bonus's sign with a gravity term, so the
+// entry saturates smoothly at +-HISTORY_MAX instead of overflowing.
+struct HistoryEntry {
+    std::int16_t value = 0;
+
+    constexpr operator std::int32_t() const noexcept { return value; }
+
+    constexpr void update(std::int32_t bonus) noexcept {
+        value += bonus - value * std::abs(bonus) / HISTORY_MAX;
+    }
+};
+
+inline constexpr std::size_t PIECE_NB = PieceType::COUNT() * Color::COUNT();
+
+// Quiet moves by side and from-to squares.
+using ButterflyHistory =
+  std::array<std::array<HistoryEntry, Square::COUNT() * Square::COUNT()>, Color::COUNT()>;
+
+// Quiet moves by moved piece and destination, given a move earlier in the line. Indexed first by
+// that earlier move's piece and destination.
+using PieceToHistory      = std::array<std::array<HistoryEntry, Square::COUNT()>, PIECE_NB>;
+using ContinuationHistory = std::array<std::array<PieceToHistory, Square::COUNT()>, PIECE_NB>;
+
+// The quiet reply that last refuted each (piece, destination).
+using CounterMoves = std::array<std::array<Move, Square::COUNT()>, PIECE_NB>;
+
+// Captures and promotions are the "noisy" moves; everything else is ordered by history.
+constexpr bool is_quiet(const Move move) noexcept {
+    return !move.is_capture() && !move.is_promotion();
+}
+
+// Hands out the moves of a position one at a time, best first, doing each stage's work only when
+// the previous stage has run dry:
+//
+//   TT move, good captures, killers, counter move, quiets, bad captures
+//
+// or, in check, the TT move and then all evasions. A capture is good unless static exchange
+// evaluation says it loses material. Moves within a stage are chosen by incremental selection over
+// a parallel score array, so a cutoff after the first few moves never pays for sorting the rest.
+// The moves are pseudo-legal except in check, where they are legal.
+class MovePicker {
+   public:
+    // `continuation` holds the piece-to tables of the moves one and two plies back; either may be
+    // null near the root.
+    MovePicker(const PositionState&                        pos,
+               const Move                                  tt_move,
+               const std::array<Move, 2>&                  killers,
+               const Move                                  counter_move,
+               const ButterflyHistory&                     history,
+               const std::array<const PieceToHistory*, 2>& continuation,
+               bool                                        in_check);
+
+    // Quiescence: every capture and promotion, by MVV-LVA.
+    explicit MovePicker(const PositionState& pos);
+
+    // Move::NONE() once every move has been returned.
+    Move next();
+
+   private:
+    enum class Stage : std::uint8_t {
+        TT_MOVE,
+        GENERATE_CAPTURES,
+        GOOD_CAPTURES,
+        KILLER_1,
+        KILLER_2,
+        COUNTER_MOVE,
+        GENERATE_QUIETS,
+        QUIETS,
+        BAD_CAPTURES,
+        EVASION_TT_MOVE,
+        GENERATE_EVASIONS,
+        EVASIONS,
+        QS_GENERATE_CAPTURES,
+        QS_CAPTURES,
+        DONE
+    };
+
+    bool is_refutation(const Move move) const noexcept;
+    bool usable_quiet(const Move move) const noexcept;
+
+    void score_captures();
+    void score_quiets();
+    void score_evasions();
+    Move select_best();
+
+    const PositionState&                 pos;
+    const ButterflyHistory*              history;
+    std::array<const PieceToHistory*, 2> continuation;
+
+    Move                tt_move;
+    std::array<Move, 2> killers;
+    Move                counter_move;
+    Stage               stage;
+
+    MoveList                                       moves;
+    std::array<std::int32_t, MoveList::capacity()> scores;
+    std::size_t                                    current;
+
+    MoveList    bad_captures;
+    std::size_t current_bad;
+};
+
+}
+
+#endif
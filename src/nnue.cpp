@@ -0,0 +1,377 @@
+#include "nnue.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(USE_AVX2) || defined(USE_SSE41)
+    #include <immintrin.h>
+#endif
+
+#if defined(VOLTA_EMBEDDED_NET)
+// The file named by `make EVALFILE=...` is assembled straight into the read-only data section.
+asm(".section .rodata\n"
+    ".balign 64\n"
+    ".global volta_embedded_net\n"
+    "volta_embedded_net:\n"
+    ".incbin \"" VOLTA_EMBEDDED_NET "\"\n"
+    ".global volta_embedded_net_end\n"
+    "volta_embedded_net_end:\n"
+    ".previous\n");
+
+extern "C" const std::byte volta_embedded_net[];
+extern "C" const std::byte volta_embedded_net_end[];
+#endif
+
+namespace Volta::Engine {
+
+namespace {
+
+#if defined(USE_AVX2) || defined(USE_SSE41)
+constexpr bool HAS_SIMD = true;
+#else
+constexpr bool HAS_SIMD = false;
+#endif
+
+constexpr std::uint32_t NNUE_MAGIC = 0x314E4E56;  // "VNN1"
+
+// Same-colored pieces come first from each perspective, and black sees the board flipped.
+std::size_t feature_index(const Color perspective, const Piece piece, const Square sq) {
+    const std::size_t side = piece.color() == perspective ? 0 : PieceType::COUNT();
+    const std::size_t relative_sq =
+      perspective == Color::WHITE() ? sq.ordinal() : static_cast<std::size_t>(sq.ordinal() ^ 56);
+
+    return ((side + piece.type().to_underlying()) * Square::COUNT() + relative_sq) * NNUE_HIDDEN;
+}
+
+// out = in + sum(added rows) - sum(removed rows), wrapping like the SIMD adds do.
+template<bool Simd>
+void apply_rows(const std::int16_t*        in,
+                std::int16_t*              out,
+                const std::int16_t* const* added,
+                std::size_t                added_count,
+                const std::int16_t* const* removed,
+                std::size_t                removed_count) {
+#if defined(USE_AVX2)
+    if constexpr (Simd)
+    {
+        for (std::size_t i = 0; i < NNUE_HIDDEN; i += 16)
+        {
+            __m256i sum = _mm256_load_si256(reinterpret_cast<const __m256i*>(in + i));
+
+            for (std::size_t k = 0; k < added_count; k++)
+                sum = _mm256_add_epi16(
+                  sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(added[k] + i)));
+
+            for (std::size_t k = 0; k < removed_count; k++)
+                sum = _mm256_sub_epi16(
+                  sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(removed[k] + i)));
+
+            _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), sum);
+        }
+
+        return;
+    }
+#elif defined(USE_SSE41)
+    if constexpr (Simd)
+    {
+        for (std::size_t i = 0; i < NNUE_HIDDEN; i += 8)
+        {
+            __m128i sum = _mm_load_si128(reinterpret_cast<const __m128i*>(in + i));
+
+            for (std::size_t k = 0; k < added_count; k++)
+                sum = _mm_add_epi16(
+                  sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(added[k] + i)));
+
+            for (std::size_t k = 0; k < removed_count; k++)
+                sum = _mm_sub_epi16(
+                  sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(removed[k] + i)));
+
+            _mm_store_si128(reinterpret_cast<__m128i*>(out + i), sum);
+        }
+
+        return;
+    }
+#endif
+
+    for (std::size_t i = 0; i < NNUE_HIDDEN; i++)
+    {
+        std::int32_t sum = in[i];
+
+        for (std::size_t k = 0; k < added_count; k++)
+            sum += added[k][i];
+
+        for (std::size_t k = 0; k < removed_count; k++)
+            sum -= removed[k][i];
+
+        out[i] = static_cast<std::int16_t>(sum);
+    }
+}
+
+// Clipped-ReLU of one perspective's accumulator dotted with its half of the output weights.
+template<bool Simd>
+std::int32_t output_dot(const std::int16_t* acc, const std::int8_t* weights) {
+#if defined(USE_AVX2)
+    if constexpr (Simd)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i qa   = _mm256_set1_epi16(NNUE_QA);
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i       sum  = _mm256_setzero_si256();
+
+        for (std::size_t i = 0; i < NNUE_HIDDEN; i += 32)
+        {
+            const __m256i lo = _mm256_min_epi16(
+              _mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(acc + i)), zero),
+              qa);
+            const __m256i hi = _mm256_min_epi16(
+              _mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(acc + i + 16)),
+                               zero),
+              qa);
+
+            // packus interleaves the 128-bit lanes of its operands; restore source order.
+            const __m256i activations =
+              _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0b11011000);
+            const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+
+            sum = _mm256_add_epi32(sum,
+                                   _mm256_madd_epi16(_mm256_maddubs_epi16(activations, w), ones));
+        }
+
+        const __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                           _mm256_extracti128_si256(sum, 1));
+        const __m128i quad = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0b01001110));
+        return _mm_cvtsi128_si32(_mm_add_epi32(quad, _mm_shuffle_epi32(quad, 0b10110001)));
+    }
+#elif defined(USE_SSE41)
+    if constexpr (Simd)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i qa   = _mm_set1_epi16(NNUE_QA);
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i       sum  = _mm_setzero_si128();
+
+        for (std::size_t i = 0; i < NNUE_HIDDEN; i += 16)
+        {
+            const __m128i lo = _mm_min_epi16(
+              _mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(acc + i)), zero), qa);
+            const __m128i hi = _mm_min_epi16(
+              _mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(acc + i + 8)), zero),
+              qa);
+
+            const __m128i activations = _mm_packus_epi16(lo, hi);
+            const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(activations, w), ones));
+        }
+
+        const __m128i quad = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0b01001110));
+        return _mm_cvtsi128_si32(_mm_add_epi32(quad, _mm_shuffle_epi32(quad, 0b10110001)));
+    }
+#endif
+
+    std::int32_t sum = 0;
+
+    for (std::size_t i = 0; i < NNUE_HIDDEN; i++)
+        sum += std::clamp<std::int32_t>(acc[i], 0, NNUE_QA) * weights[i];
+
+    return sum;
+}
+
+}  // namespace
+
+Network::~Network() { unload(); }
+
+const char* Network::kernel_name() noexcept {
+#if defined(USE_AVX2)
+    return "avx2";
+#elif defined(USE_SSE41)
+    return "sse4.1";
+#else
+    return "scalar";
+#endif
+}
+
+bool Network::load_file(const std::string& path) {
+    unload();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    void*       data = MAP_FAILED;
+
+    if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == file_size())
+        data = ::mmap(nullptr, file_size(), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    mapping      = data;
+    mapping_size = file_size();
+
+    if (bind(static_cast<const std::byte*>(data), file_size()))
+        return true;
+
+    unload();
+    return false;
+}
+
+bool Network::load_embedded() {
+    unload();
+
+#if defined(VOLTA_EMBEDDED_NET)
+    return bind(volta_embedded_net,
+                static_cast<std::size_t>(volta_embedded_net_end - volta_embedded_net));
+#else
+    return false;
+#endif
+}
+
+bool Network::load_buffer(std::vector<std::byte> data) {
+    unload();
+    buffer = std::move(data);
+
+    if (bind(buffer.data(), buffer.size()))
+        return true;
+
+    unload();
+    return false;
+}
+
+// Points the weight arrays into `data` after checking the header and size. Multi-byte weights are
+// read in place, so `data` must be at least 2-byte aligned and little-endian.
+bool Network::bind(const std::byte* data, std::size_t size) {
+    std::uint32_t magic;
+    std::uint32_t hidden;
+
+    if (size != file_size())
+        return false;
+
+    std::memcpy(&magic, data, 4);
+    std::memcpy(&hidden, data + 4, 4);
+
+    if (magic != NNUE_MAGIC || hidden != NNUE_HIDDEN)
+        return false;
+
+    const std::byte* cursor = data + 8;
+
+    feature_weights = reinterpret_cast<const std::int16_t*>(cursor);
+    cursor += NNUE_INPUTS * NNUE_HIDDEN * 2;
+    feature_biases = reinterpret_cast<const std::int16_t*>(cursor);
+    cursor += NNUE_HIDDEN * 2;
+    output_weights = reinterpret_cast<const std::int8_t*>(cursor);
+    cursor += 2 * NNUE_HIDDEN;
+    std::memcpy(&output_bias, cursor, 4);
+
+    return true;
+}
+
+void Network::unload() {
+    if (mapping)
+        ::munmap(mapping, mapping_size);
+
+    mapping         = nullptr;
+    mapping_size    = 0;
+    feature_weights = nullptr;
+    feature_biases  = nullptr;
+    output_weights  = nullptr;
+    output_bias     = 0;
+    buffer.clear();
+}
+
+void Network::refresh(const PositionState& pos, Accumulator& acc, NnueKernel kernel) const {
+    assert(loaded());
+
+    for (const Color perspective : {Color::WHITE(), Color::BLACK()})
+    {
+        std::array<const std::int16_t*, 32> rows;
+        std::size_t                         count = 0;
+
+        BitBoard occ = pos.bb(Color::WHITE(), Color::BLACK());
+
+        while (occ)
+        {
+            const Square sq = Square::from_ordinal(occ.pop_lsb());
+            rows[count++]   = feature_weights + feature_index(perspective, pos.piece_on(sq), sq);
+        }
+
+        std::int16_t* out = acc.values[perspective.to_underlying()].data();
+
+        // Bias first, then the pieces; the sum of a few rows at a time keeps the loop count low.
+        std::memcpy(out, feature_biases, NNUE_HIDDEN * sizeof(std::int16_t));
+
+        for (std::size_t i = 0; i < count; i += 4)
+        {
+            const std::size_t n = std::min<std::size_t>(4, count - i);
+
+            if (kernel == NnueKernel::NATIVE && HAS_SIMD)
+                apply_rows<true>(out, out, rows.data() + i, n, nullptr, 0);
+            else
+                apply_rows<false>(out, out, rows.data() + i, n, nullptr, 0);
+        }
+    }
+}
+
+void Network::update(const Accumulator& parent,
+                     Accumulator&       child,
+                     const DirtyPieces& dirty,
+                     NnueKernel         kernel) const {
+    assert(loaded());
+
+    for (const Color perspective : {Color::WHITE(), Color::BLACK()})
+    {
+        std::array<const std::int16_t*, 2> added;
+        std::array<const std::int16_t*, 2> removed;
+
+        for (std::size_t i = 0; i < dirty.added_count; i++)
+        {
+            const DirtyPieces::Entry& entry = dirty.added[i];
+            added[i] = feature_weights + feature_index(perspective, entry.piece, entry.square);
+        }
+
+        for (std::size_t i = 0; i < dirty.removed_count; i++)
+        {
+            const DirtyPieces::Entry& entry = dirty.removed[i];
+            removed[i] = feature_weights + feature_index(perspective, entry.piece, entry.square);
+        }
+
+        const std::int16_t* in  = parent.values[perspective.to_underlying()].data();
+        std::int16_t*       out = child.values[perspective.to_underlying()].data();
+
+        if (kernel == NnueKernel::NATIVE && HAS_SIMD)
+            apply_rows<true>(in, out, added.data(), dirty.added_count, removed.data(),
+                             dirty.removed_count);
+        else
+            apply_rows<false>(in, out, added.data(), dirty.added_count, removed.data(),
+                              dirty.removed_count);
+    }
+}
+
+Value Network::evaluate(const Accumulator& acc, const Color stm, NnueKernel kernel) const {
+    assert(loaded());
+
+    const std::int16_t* us   = acc.values[stm.to_underlying()].data();
+    const std::int16_t* them = acc.values[(~stm).to_underlying()].data();
+
+    const std::int8_t* us_weights   = output_weights;
+    const std::int8_t* them_weights = output_weights + NNUE_HIDDEN;
+
+    const std::int32_t sum =
+      kernel == NnueKernel::NATIVE && HAS_SIMD
+        ? output_dot<true>(us, us_weights) + output_dot<true>(them, them_weights)
+        : output_dot<false>(us, us_weights) + output_dot<false>(them, them_weights);
+
+    return static_cast<Value>(static_cast<std::int64_t>(sum + output_bias) * NNUE_SCALE
+                              / (NNUE_QA * NNUE_QB));
+}
+
+}
@@ -0,0 +1,103 @@
+#ifndef VOLTA_NNUE_HPP__
+#define VOLTA_NNUE_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "evaluate.hpp"
+#include "position.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+// (768 -> HIDDEN) x 2 -> 1. Every (piece, square) pair is a feature, seen once from each side's
+// perspective; the two halves share weights, and the side to move's half comes first at the
+// output.
+inline constexpr std::size_t NNUE_INPUTS = 768;
+inline constexpr std::size_t NNUE_HIDDEN = 256;
+
+// Clipped ReLU ceiling, output weight scale and final centipawn scale. Activations fit in a byte,
+// so the output layer is an unsigned-by-signed byte dot product.
+inline constexpr std::int32_t NNUE_QA    = 127;
+inline constexpr std::int32_t NNUE_QB    = 64;
+inline constexpr std::int32_t NNUE_SCALE = 400;
+
+// First-layer sums for both perspectives, indexed by color.
+struct alignas(64) Accumulator {
+    std::array<std::array<std::int16_t, NNUE_HIDDEN>, Color::COUNT()> values;
+};
+
+enum class NnueKernel : std::uint8_t {
+    SCALAR,
+    NATIVE
+};
+
+// Network weights, either mapped from a file, embedded in the binary at build time
+// (`make EVALFILE=<net>`), or held in a caller-supplied buffer. File layout, little-endian:
+//
+//   char[4]  "VNN1"
+//   uint32   hidden size (must equal NNUE_HIDDEN)
+//   int16    feature weights [NNUE_INPUTS][NNUE_HIDDEN]
+//   int16    feature biases  [NNUE_HIDDEN]
+//   int8     output weights  [2][NNUE_HIDDEN], side to move first
+//   int32    output bias
+//
+// NATIVE kernels use AVX2 or SSE4.1 when built with `ARCH=avx2` or `ARCH=sse41`, and the scalar
+// code otherwise. Both produce bit-identical results.
+class Network {
+   public:
+    Network() = default;
+    ~Network();
+
+    Network(const Network&)            = delete;
+    Network& operator=(const Network&) = delete;
+
+    static constexpr std::size_t file_size() noexcept {
+        return 8 + NNUE_INPUTS * NNUE_HIDDEN * 2 + NNUE_HIDDEN * 2 + 2 * NNUE_HIDDEN + 4;
+    }
+
+    static const char* kernel_name() noexcept;
+
+    // Each loader replaces the current weights on success and leaves the network empty on failure.
+    bool load_file(const std::string& path);
+    bool load_embedded();
+    bool load_buffer(std::vector<std::byte> data);
+
+    bool loaded() const noexcept { return feature_weights != nullptr; }
+
+    void refresh(const PositionState& pos,
+                 Accumulator&         acc,
+                 NnueKernel           kernel = NnueKernel::NATIVE) const;
+
+    // Derives the child's accumulator from its parent's and the move's placed and lifted pieces.
+    void update(const Accumulator& parent,
+                Accumulator&       child,
+                const DirtyPieces& dirty,
+                NnueKernel         kernel = NnueKernel::NATIVE) const;
+
+    Value evaluate(const Accumulator& acc,
+                   const Color        stm,
+                   NnueKernel         kernel = NnueKernel::NATIVE) const;
+
+   private:
+    bool bind(const std::byte* data, std::size_t size);
+    void unload();
+
+    const std::int16_t* feature_weights = nullptr;
+    const std::int16_t* feature_biases  = nullptr;
+    const std::int8_t*  output_weights  = nullptr;
+    std::int32_t        output_bias     = 0;
+
+    void*                  mapping      = nullptr;
+    std::size_t            mapping_size = 0;
+    std::vector<std::byte> buffer;
+};
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "pawns.hpp"
+
+#include "attacks.hpp"
+#include "bbmanip.hpp"
+
+namespace Volta::Engine {
+
+namespace {
+
+using Chess::Detail::S;
+
+constexpr Score DOUBLED  = S(-10, -25);
+constexpr Score ISOLATED = S(-10, -15);
+constexpr Score BACKWARD = S(-8, -12);
+
+// By rank from the owner's side.
+constexpr std::array<Score, 8> PASSED = {S(0, 0),   S(0, 10),  S(5, 15),   S(10, 25),
+                                         S(20, 45), S(35, 75), S(60, 120), S(0, 0)};
+
+Direction forward(const Color color) {
+    return color == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
+}
+
+// Fills in every field of `entry` but the key. Both sides' spans are needed before either side's
+// pawns can be classified.
+void evaluate_pawns(const PositionState& pos, PawnEntry& entry) {
+    std::array<BitBoard, Color::COUNT()> front_span;
+
+    for (const Color color : {Color::WHITE(), Color::BLACK()})
+    {
+        const std::size_t c    = color.to_underlying();
+        const BitBoard    ours = pos.bb(Piece::make(PieceType::PAWN(), color));
+
+        entry.attacks[c]     = Attacks::pawn_attacks(ours, color);
+        entry.attack_span[c] = fill(entry.attacks[c], forward(color));
+        front_span[c]        = fill(shift(ours, forward(color)), forward(color));
+    }
+
+    entry.score = Score{};
+
+    for (const Color color : {Color::WHITE(), Color::BLACK()})
+    {
+        const std::size_t us   = color.to_underlying();
+        const std::size_t them = (~color).to_underlying();
+        const Direction   down = forward(~color);
+        const BitBoard    ours = pos.bb(Piece::make(PieceType::PAWN(), color));
+
+        const BitBoard files = fill(fill(ours, Direction::NORTH()), Direction::SOUTH());
+        const BitBoard neighbors =
+          shift(files, Direction::EAST()) | shift(files, Direction::WEST());
+
+        // The front pawn of each pair on a file, and pawns with no friendly pawn on either side.
+        const BitBoard doubled  = ours & front_span[us];
+        const BitBoard isolated = ours & ~neighbors;
+
+        // Pawns whose stop square an enemy pawn controls, with no neighbor level or behind that
+        // could ever come up to support them.
+        const BitBoard backward = ours & ~isolated & shift(entry.attacks[them], down)
+                                & ~shift(entry.attack_span[us], down);
+
+        // No enemy pawn ahead on this or an adjacent file, and no friendly pawn in front either.
+        BitBoard passed = ours & ~(front_span[them] | entry.attack_span[them])
+                        & ~fill(shift(ours, down), down);
+
+        entry.passed[us] = passed;
+
+        Score score = DOUBLED * doubled.popcount() + ISOLATED * isolated.popcount()
+                    + BACKWARD * backward.popcount();
+
+        while (passed)
+        {
+            const Square sq   = Square::from_ordinal(passed.pop_lsb());
+            const auto   rank = sq.rank().to_underlying();
+
+            score += PASSED[color == Color::WHITE() ? rank : 7 - rank];
+        }
+
+        entry.score += color == Color::WHITE() ? score : -score;
+    }
+}
+
+}  // namespace
+
+PawnTable::PawnTable() :
+    entries{std::make_unique<PawnEntry[]>(SIZE)} {}
+
+const PawnEntry& PawnTable::probe(const PositionState& pos) {
+    const std::uint64_t key   = pos.pawn_key();
+    PawnEntry&          entry = entries[key & (SIZE - 1)];
+
+    if (entry.key != key)
+    {
+        entry.key = key;
+        evaluate_pawns(pos, entry);
+    }
+
+    return entry;
+}
+
+}
@@ -0,0 +1,46 @@
+#ifndef VOLTA_PAWNS_HPP__
+#define VOLTA_PAWNS_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "bitboard.hpp"
+#include "common.hpp"
+#include "position.hpp"
+#include "psqt.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+// Everything about a position that depends on the pawns alone. `score` is from White's point of
+// view. Attack spans are the squares a side's pawns attack now or could attack by advancing.
+struct PawnEntry {
+    std::uint64_t                        key;
+    Score                                score;
+    std::array<BitBoard, Color::COUNT()> attacks;
+    std::array<BitBoard, Color::COUNT()> attack_span;
+    std::array<BitBoard, Color::COUNT()> passed;
+};
+
+// Pawn structure evaluations by pawn key, one table per search thread so that it needs no
+// synchronisation. Pawns rarely move within a search tree, so nearly every probe is a hit.
+class PawnTable {
+   public:
+    static constexpr std::size_t SIZE = std::size_t{1} << 14;
+
+    PawnTable();
+
+    // The entry for `pos`'s pawns, evaluated and stored first if the slot holds other pawns.
+    const PawnEntry& probe(const PositionState& pos);
+
+   private:
+    // Zero-initialised, which is already the correct entry for a position without pawns.
+    std::unique_ptr<PawnEntry[]> entries;
+};
+
+}
+
+#endif
@@ -1,50 +1,251 @@
 #include "perft.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "movegen.hpp"
+#include "threadpool.hpp"
 
 namespace Volta {
 
 namespace Chess {
 
+namespace {
+
+struct alignas(64) WorkerStats {
+    std::uint64_t nodes    = 0;
+    double        busy_sec = 0.0;
+};
+
+struct ParallelPerft {
+    std::int32_t                                  split_depth;
+    PerftTable*                                   table;
+    std::vector<WorkerStats>                      stats;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> root_counts;
+    Utility::ThreadPool                           pool;
+
+    ParallelPerft(std::size_t  threads,
+                  std::int32_t split,
+                  PerftTable*  perft_table,
+                  std::size_t  root_moves) :
+        split_depth{split},
+        table{perft_table},
+        stats(threads),
+        root_counts{std::make_unique<std::atomic<std::uint64_t>[]>(root_moves)},
+        pool{threads} {}
+
+    void spawn(const PositionState& pos, std::int32_t depth, std::int32_t ply, std::size_t root);
+};
+
+void ParallelPerft::spawn(const PositionState& pos,
+                          std::int32_t         depth,
+                          std::int32_t         ply,
+                          std::size_t          root) {
+    pool.submit([this, pos, depth, ply, root](std::size_t worker) {
+        const auto start = std::chrono::steady_clock::now();
+
+        if (ply >= split_depth || depth <= 1)
+        {
+            const std::uint64_t nodes = table ? perft(pos, depth, *table) : perft(pos, depth);
+            root_counts[root].fetch_add(nodes, std::memory_order_relaxed);
+            stats[worker].nodes += nodes;
+        }
+        else
+        {
+            MoveList moves;
+            append_legal_moves(moves, pos);
+
+            for (const auto move : moves)
+            {
+                PositionState newPos = pos;
+                newPos.make_move(move);
+
+                spawn(newPos, depth - 1, ply + 1, root);
+            }
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        stats[worker].busy_sec += elapsed.count();
+    });
+}
+
+template<typename Policy>
+std::uint64_t perft_impl(PositionState& pos, std::int32_t depth) {
+    if (depth == 0)
+        return 1;
+
+    // Bulk-count the frontier instead of playing out every leaf.
+    if (depth == 1)
+        return count_legal_moves(pos);
+
+    MoveList moves;
+    append_legal_moves(moves, pos);
+
+    std::uint64_t counter = 0;
+
+    for (const auto move : moves)
+    {
+        counter += Policy::visit(pos, move, [depth](PositionState& child) {
+            return perft_impl<Policy>(child, depth - 1);
+        });
+    }
+
+    return counter;
+}
+
+template<typename Policy>
+std::uint64_t hashed_perft(PositionState& pos, std::int32_t depth, PerftTable& table) {
+    if (depth <= 1)
+        return perft_impl<Policy>(pos, depth);
+
+    const std::uint64_t key = pos.key();
+
+    std::uint64_t counter = 0;
+    if (table.probe(key, depth, counter))
+        return counter;
+
+    MoveList moves;
+    append_legal_moves(moves, pos);
+
+    for (const auto move : moves)
+    {
+        counter += Policy::visit(pos, move, [depth, &table](PositionState& child) {
+            return hashed_perft<Policy>(child, depth - 1, table);
+        });
+    }
+
+    table.store(key, depth, counter);
+    return counter;
+}
+
+constexpr std::uint64_t DEPTH_BITS = 8;
+constexpr std::uint64_t DEPTH_MASK = (1ULL << DEPTH_BITS) - 1;
+
+}  // namespace
+
+PerftTable::PerftTable(std::size_t megabytes) {
+    const std::size_t budget = std::max<std::size_t>(megabytes, 1) * 1024 * 1024;
+    std::size_t       count  = 1;
+
+    while (count * 2 * sizeof(Entry) <= budget)
+        count *= 2;
+
+    entries = std::make_unique<Entry[]>(count);
+    mask    = count - 1;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        entries[i].key_xor_data.store(0, std::memory_order_relaxed);
+        entries[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool PerftTable::probe(std::uint64_t  key,
+                       std::int32_t   depth,
+                       std::uint64_t& count) const noexcept {
+    const Entry&        entry = entries[key & mask];
+    const std::uint64_t data  = entry.data.load(std::memory_order_relaxed);
+
+    if ((entry.key_xor_data.load(std::memory_order_relaxed) ^ data) != key)
+        return false;
+
+    if ((data & DEPTH_MASK) != static_cast<std::uint64_t>(depth))
+        return false;
+
+    count = data >> DEPTH_BITS;
+    return true;
+}
+
+void PerftTable::store(std::uint64_t key, std::int32_t depth, std::uint64_t count) noexcept {
+    Entry&              entry = entries[key & mask];
+    const std::uint64_t data  = (count << DEPTH_BITS) | static_cast<std::uint64_t>(depth);
+
+    entry.key_xor_data.store(key ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
 void split_perft(const PositionState& pos, std::int32_t depth) {
     MoveList moves;
-    append_all_moves(moves, pos);
+    append_legal_moves(moves, pos);
 
     for (const auto move : moves)
     {
         PositionState newPos = pos;
         newPos.make_move(move);
 
-        if (!newPos.is_ok())
-            continue;
-
         std::cout << move.to_uci() << " " << perft(newPos, depth - 1) << std::endl;
     }
 }
 
+template<typename Policy>
 std::uint64_t perft(const PositionState& pos, std::int32_t depth) {
-    if (depth == 0)
-        return 1;
+    PositionState root = pos;
+    return perft_impl<Policy>(root, depth);
+}
+
+template std::uint64_t perft<CopyMake>(const PositionState& pos, std::int32_t depth);
+template std::uint64_t perft<MakeUnmake>(const PositionState& pos, std::int32_t depth);
+
+std::uint64_t perft(const PositionState& pos, std::int32_t depth) {
+    return perft<DefaultPerftPolicy>(pos, depth);
+}
+
+std::uint64_t perft(const PositionState& pos, std::int32_t depth, PerftTable& table) {
+    PositionState root = pos;
+    return hashed_perft<DefaultPerftPolicy>(root, depth, table);
+}
+
+std::uint64_t parallel_split_perft(const PositionState& pos,
+                                   std::int32_t         depth,
+                                   std::size_t          threads,
+                                   std::int32_t         split_depth,
+                                   PerftTable*          table) {
+    assert(depth > 0);
 
     MoveList moves;
-    append_all_moves(moves, pos);
+    append_legal_moves(moves, pos);
 
-    std::uint64_t counter = 0;
+    const auto    start = std::chrono::steady_clock::now();
+    ParallelPerft state{threads, split_depth, table, moves.size()};
 
-    for (const auto move : moves)
+    for (std::size_t i = 0; i < moves.size(); i++)
     {
         PositionState newPos = pos;
-        newPos.make_move(move);
+        newPos.make_move(moves[i]);
+        state.spawn(newPos, depth - 1, 1, i);
+    }
+
+    state.pool.wait();
 
-        if (!newPos.is_ok())
-            continue;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
 
-        counter += perft(newPos, depth - 1);
+    std::uint64_t total = 0;
+
+    for (std::size_t i = 0; i < moves.size(); i++)
+    {
+        const std::uint64_t count = state.root_counts[i].load(std::memory_order_relaxed);
+        std::cout << moves[i].to_uci() << " " << count << std::endl;
+        total += count;
     }
 
-    return counter;
+    std::cout << "\nNodes searched: " << total << "\n";
+    std::cout << "Time: " << elapsed.count() << " s, "
+              << static_cast<std::uint64_t>(total / elapsed.count()) << " nps\n";
+
+    for (std::size_t i = 0; i < state.stats.size(); i++)
+    {
+        const WorkerStats& stats = state.stats[i];
+        const double       nps   = stats.busy_sec > 0 ? stats.nodes / stats.busy_sec : 0.0;
+
+        std::cout << "thread " << i << ": " << stats.nodes << " nodes, "
+                  << static_cast<std::uint64_t>(nps) << " nps" << std::endl;
+    }
+
+    return total;
 }
 
 }
@@ -1,7 +1,10 @@
 #ifndef VOLTA_PERFT_HPP__
 #define VOLTA_PERFT_HPP__
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 
 #include "position.hpp"
 
@@ -9,9 +12,67 @@ namespace Volta {
 
 namespace Chess {
 
-void          split_perft(const PositionState& pos, std::int32_t depth);
+// Fixed-size table of (key, depth, count) entries. The node count and depth share one word and
+// the stored key is XORed with it, so a torn write from another thread fails verification instead
+// of returning a wrong count.
+class PerftTable {
+   public:
+    explicit PerftTable(std::size_t megabytes);
+
+    bool probe(std::uint64_t key, std::int32_t depth, std::uint64_t& count) const noexcept;
+    void store(std::uint64_t key, std::int32_t depth, std::uint64_t count) noexcept;
+
+   private:
+    struct Entry {
+        std::atomic<std::uint64_t> key_xor_data;
+        std::atomic<std::uint64_t> data;
+    };
+
+    std::unique_ptr<Entry[]> entries;
+    std::uint64_t            mask;
+};
+
+// How perft descends into a child. CopyMake plays the move on a copy of the parent; MakeUnmake
+// plays it in place and restores the parent from an UndoInfo afterwards.
+struct CopyMake {
+    template<typename Visitor>
+    static std::uint64_t visit(PositionState& pos, const Move move, Visitor&& visitor) {
+        PositionState child = pos;
+        child.make_move(move);
+        return visitor(child);
+    }
+};
+
+struct MakeUnmake {
+    template<typename Visitor>
+    static std::uint64_t visit(PositionState& pos, const Move move, Visitor&& visitor) {
+        UndoInfo undo;
+        pos.make_move(move, undo);
+        const std::uint64_t count = visitor(pos);
+        pos.unmake_move(move, undo);
+        return count;
+    }
+};
+
+using DefaultPerftPolicy = MakeUnmake;
+
+void split_perft(const PositionState& pos, std::int32_t depth);
+
+template<typename Policy>
 std::uint64_t perft(const PositionState& pos, std::int32_t depth);
 
+std::uint64_t perft(const PositionState& pos, std::int32_t depth);
+std::uint64_t perft(const PositionState& pos, std::int32_t depth, PerftTable& table);
+
+// Divide perft on a work-stealing pool. Every node shallower than split_depth plies is expanded
+// into one task per legal child, and the subtrees below it are counted serially by whichever
+// worker picks them up. A non-null table is shared by all workers.
+std::uint64_t parallel_split_perft(const PositionState& pos,
+                                   std::int32_t         depth,
+                                   std::size_t          threads,
+                                   std::int32_t         split_depth,
+                                   PerftTable*          table = nullptr);
+
 }
 
 }
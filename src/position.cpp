@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include <string_view>
 #include <ranges>
@@ -6,12 +7,15 @@
 
 #include "attacks.hpp"
 #include "bbmanip.hpp"
+#include "castling.hpp"
 #include "common.hpp"
 #include "coordinates.hpp"
 #include "move.hpp"
 #include "piece.hpp"
 #include "position.hpp"
+#include "psqt.hpp"
 #include "utility.hpp"
+#include "zobrist.hpp"
 
 namespace Volta::Chess {
 
@@ -19,6 +23,7 @@ Piece PositionState::piece_on(const Square square) const noexcept {
     return mailbox[square.ordinal()];
 }
 
+template<bool UpdateKeys>
 void PositionState::add_piece(const Piece piece, const Square square) noexcept {
     assert(piece.is_valid());
     assert(square.is_valid());
@@ -26,11 +31,26 @@ void PositionState::add_piece(const Piece piece, const Square square) noexcept {
     const Color     color      = piece.color();
     const PieceType piece_type = piece.type();
 
+    if constexpr (UpdateKeys)
+        material_key_ ^= Zobrist::piece_square(piece, Square::from_ordinal(bb(piece).popcount()));
+
     by_color[color.to_underlying()].set(square.ordinal());
     by_piece_type[piece_type.to_underlying()].set(square.ordinal());
     mailbox[square.ordinal()] = piece;
+
+    psqt_ += Psqt::score(piece, square);
+    phase_ += Psqt::phase(piece_type);
+
+    if constexpr (UpdateKeys)
+    {
+        key_ ^= Zobrist::piece_square(piece, square);
+
+        if (piece_type == PieceType::PAWN())
+            pawn_key_ ^= Zobrist::piece_square(piece, square);
+    }
 }
 
+template<bool UpdateKeys>
 void PositionState::remove_piece(const Piece piece, const Square square) noexcept {
     assert(piece.is_valid());
     assert(square.is_valid());
@@ -41,8 +61,23 @@ void PositionState::remove_piece(const Piece piece, const Square square) noexcep
     by_color[color.to_underlying()].clear(square.ordinal());
     by_piece_type[piece_type.to_underlying()].clear(square.ordinal());
     mailbox[square.ordinal()] = Piece::NONE();
+
+    psqt_ -= Psqt::score(piece, square);
+    phase_ -= Psqt::phase(piece_type);
+
+    if constexpr (UpdateKeys)
+    {
+        material_key_ ^= Zobrist::piece_square(piece, Square::from_ordinal(bb(piece).popcount()));
+        key_ ^= Zobrist::piece_square(piece, square);
+
+        if (piece_type == PieceType::PAWN())
+            pawn_key_ ^= Zobrist::piece_square(piece, square);
+    }
 }
 
+// from_fen is defined in the header and places pieces through the hashing overloads.
+template void PositionState::add_piece<true>(const Piece piece, const Square square) noexcept;
+
 void PositionState::make_move(const Move move) noexcept {
     const Square from           = move.from();
     const Square to             = move.to();
@@ -50,17 +85,41 @@ void PositionState::make_move(const Move move) noexcept {
     const Piece  captured_piece = piece_on(move.to());
 
     rule50++;
+
+    if (en_passant_destination_.is_valid())
+        key_ ^= Zobrist::en_passant(en_passant_destination_.file());
+
     en_passant_destination_ = Square::NONE();
 
     if (move.is_castling())
     {
-        // unimplemented
+        const Detail::CastlingPath& path = Castling::path(stm(), to);
+        const Piece                 rook = Piece::make(PieceType::ROOK(), stm());
+
+        remove_piece(moved_piece, path.king_from);
+        remove_piece(rook, path.rook_from);
+        add_piece(moved_piece, path.king_to);
+        add_piece(rook, path.rook_to);
+
+        dirty_pieces_ = {.added         = {{{moved_piece, path.king_to}, {rook, path.rook_to}}},
+                         .removed       = {{{moved_piece, path.king_from}, {rook, path.rook_from}}},
+                         .added_count   = 2,
+                         .removed_count = 2};
     }
     else
     {
+        const Piece placed =
+          move.is_promotion() ? Piece::make(move.promtion_piece(), stm()) : moved_piece;
+
+        dirty_pieces_.added[0]      = {placed, to};
+        dirty_pieces_.removed[0]    = {moved_piece, from};
+        dirty_pieces_.added_count   = 1;
+        dirty_pieces_.removed_count = 1;
+
         if (captured_piece.is_valid())
         {
             remove_piece(captured_piece, to);
+            dirty_pieces_.removed[dirty_pieces_.removed_count++] = {captured_piece, to};
             rule50 = 0;
         }
 
@@ -71,30 +130,263 @@ void PositionState::make_move(const Move move) noexcept {
         {
             if (move.is_ep())
             {
-                remove_piece(Piece::make(PieceType::PAWN(), ~stm()),
-                             shift(move.to(), push_dir.reverse()));
+                const Piece  captured_pawn = Piece::make(PieceType::PAWN(), ~stm());
+                const Square captured_sq   = shift(move.to(), push_dir.reverse());
+
+                remove_piece(captured_pawn, captured_sq);
+                dirty_pieces_.removed[dirty_pieces_.removed_count++] = {captured_pawn, captured_sq};
             }
 
             if (distance(from.rank(), to.rank()) == 2)
             {
                 en_passant_destination_ = shift(to, push_dir.reverse());
+                key_ ^= Zobrist::en_passant(en_passant_destination_.file());
             }
 
             rule50 = 0;
         }
 
         remove_piece(moved_piece, from);
-
-        if (move.is_promotion())
-            add_piece(Piece::make(move.promtion_piece(), stm()), to);
-        else
-            add_piece(moved_piece, to);
+        add_piece(placed, to);
     }
 
+    key_ ^= Zobrist::castling(castling_rights_);
+    castling_rights_ &= Castling::rights_mask(from) & Castling::rights_mask(to);
+    key_ ^= Zobrist::castling(castling_rights_);
+
     side_to_move = ~side_to_move;
+    key_ ^= Zobrist::side();
+
+    update_check_info();
+
+    assert(key_ == compute_key());
+    assert(pawn_key_ == compute_pawn_key());
+    assert(material_key_ == compute_material_key());
+    assert(psqt_ == compute_psqt());
+    assert(phase_ == compute_phase());
+}
+
+void PositionState::make_move(const Move move, UndoInfo& undo) noexcept {
+    undo.captured               = piece_on(move.to());
+    undo.en_passant_destination = en_passant_destination_;
+    undo.rule50                 = rule50;
+    undo.castling_rights        = castling_rights_;
+    undo.key                    = key_;
+    undo.pawn_key               = pawn_key_;
+    undo.material_key           = material_key_;
+    undo.checkers               = checkers_;
+    undo.blockers_for_king      = blockers_for_king_;
+    undo.pinners                = pinners_;
+    undo.check_squares          = check_squares_;
+
+    make_move(move);
 }
 
-bool PositionState::is_legal(const Move move) const noexcept { return true; }
+// Reverses make_move(move, undo). Pieces are put back without touching the hashes, which are then
+// copied out of the undo record along with the check information.
+void PositionState::unmake_move(const Move move, const UndoInfo& undo) noexcept {
+    const Square from = move.from();
+    const Square to   = move.to();
+
+    side_to_move = ~side_to_move;
+
+    if (move.is_castling())
+    {
+        const Detail::CastlingPath& path = Castling::path(stm(), to);
+        const Piece                 king = Piece::make(PieceType::KING(), stm());
+        const Piece                 rook = Piece::make(PieceType::ROOK(), stm());
+
+        remove_piece<false>(king, path.king_to);
+        remove_piece<false>(rook, path.rook_to);
+        add_piece<false>(king, path.king_from);
+        add_piece<false>(rook, path.rook_from);
+    }
+    else
+    {
+        const Piece moved_piece =
+          move.is_promotion() ? Piece::make(PieceType::PAWN(), stm()) : piece_on(to);
+
+        remove_piece<false>(piece_on(to), to);
+        add_piece<false>(moved_piece, from);
+
+        if (undo.captured.is_valid())
+            add_piece<false>(undo.captured, to);
+
+        if (move.is_ep())
+        {
+            const Direction push_dir =
+              side_to_move == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
+
+            add_piece<false>(Piece::make(PieceType::PAWN(), ~stm()),
+                             shift(to, push_dir.reverse()));
+        }
+    }
+
+    en_passant_destination_ = undo.en_passant_destination;
+    rule50                  = undo.rule50;
+    castling_rights_        = undo.castling_rights;
+    key_                    = undo.key;
+    pawn_key_               = undo.pawn_key;
+    material_key_           = undo.material_key;
+    checkers_               = undo.checkers;
+    blockers_for_king_      = undo.blockers_for_king;
+    pinners_                = undo.pinners;
+    check_squares_          = undo.check_squares;
+
+    assert(key_ == compute_key());
+    assert(pawn_key_ == compute_pawn_key());
+    assert(material_key_ == compute_material_key());
+    assert(psqt_ == compute_psqt());
+    assert(phase_ == compute_phase());
+}
+
+BitBoard PositionState::attackers_to(const Square square, const BitBoard occ) const noexcept {
+    const BitBoard sq_bb = square.to_bb();
+
+    return (Attacks::pawn_attacks(sq_bb, Color::BLACK()) & bb(Piece::WHITE_PAWN()))
+         | (Attacks::pawn_attacks(sq_bb, Color::WHITE()) & bb(Piece::BLACK_PAWN()))
+         | (Attacks::knight_attacks(square) & bb(PieceType::KNIGHT()))
+         | (Attacks::king_attacks(square) & bb(PieceType::KING()))
+         | (Attacks::bishop_attacks(square, occ) & bb(PieceType::BISHOP(), PieceType::QUEEN()))
+         | (Attacks::rook_attacks(square, occ) & bb(PieceType::ROOK(), PieceType::QUEEN()));
+}
+
+// Whether `move`, flag included, is one that append_all_moves would generate in this position. Used
+// to vet moves that come from outside the generator.
+bool PositionState::is_pseudo_legal(const Move move) const noexcept {
+    const Square from  = move.from();
+    const Square to    = move.to();
+    const Piece  piece = piece_on(from);
+
+    if (!piece.is_valid() || piece.color() != stm())
+        return false;
+
+    if (move.is_castling())
+    {
+        const Detail::CastlingPath& path = Castling::path(stm(), to);
+        return path.king_from == from && path.king_to == to && can_castle(path);
+    }
+
+    const BitBoard occ      = bb(Color::WHITE(), Color::BLACK());
+    const Piece    captured = piece_on(to);
+
+    if (captured.is_valid() && captured.color() == stm())
+        return false;
+
+    if (move.is_ep())
+    {
+        return piece.type() == PieceType::PAWN() && to == en_passant_destination_
+            && (Attacks::pawn_attacks(from.to_bb(), stm()) & to.to_bb());
+    }
+
+    if (move.is_capture() != captured.is_valid())
+        return false;
+
+    if (piece.type() == PieceType::PAWN())
+    {
+        const BitBoard  promotion_rank = stm() == Color::WHITE() ? Rank::RANK_8() : Rank::RANK_1();
+        const BitBoard  starting_rank  = stm() == Color::WHITE() ? Rank::RANK_2() : Rank::RANK_7();
+        const Direction push_dir = stm() == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
+
+        if (move.is_promotion() != static_cast<bool>(promotion_rank & to.to_bb()))
+            return false;
+
+        if (move.is_capture())
+            return static_cast<bool>(Attacks::pawn_attacks(from.to_bb(), stm()) & to.to_bb());
+
+        const BitBoard single_push = shift(from.to_bb(), push_dir) & ~occ;
+        const BitBoard double_push =
+          shift(single_push & shift(starting_rank, push_dir), push_dir) & ~occ;
+
+        return static_cast<bool>((single_push | double_push) & to.to_bb());
+    }
+
+    if (move.is_promotion())
+        return false;
+
+    BitBoard attacks;
+
+    switch (piece.type().to_underlying())
+    {
+    case PieceType::KNIGHT().to_underlying() :
+        attacks = Attacks::knight_attacks(from);
+        break;
+    case PieceType::BISHOP().to_underlying() :
+        attacks = Attacks::bishop_attacks(from, occ);
+        break;
+    case PieceType::ROOK().to_underlying() :
+        attacks = Attacks::rook_attacks(from, occ);
+        break;
+    case PieceType::QUEEN().to_underlying() :
+        attacks = Attacks::queen_attacks(from, occ);
+        break;
+    default :
+        attacks = Attacks::king_attacks(from);
+        break;
+    }
+
+    return static_cast<bool>(attacks & to.to_bb());
+}
+
+// Tests a pseudo-legal move for the side to move without playing it. King moves and en passant
+// are checked against the occupancy after the move; every other move only has to answer a check
+// if there is one and stay on its pin line if it is pinned.
+bool PositionState::is_legal(const Move move) const noexcept {
+    const Square   from = move.from();
+    const Square   to   = move.to();
+    const Square   ksq  = king_square(stm());
+    const BitBoard them = bb(~stm());
+    const BitBoard occ  = bb(Color::WHITE(), Color::BLACK());
+
+    if (move.is_castling())
+        return can_castle(Castling::path(stm(), to));
+
+    if (from == ksq)
+        return !(attackers_to(to, occ ^ from.to_bb()) & them);
+
+    if (move.is_ep())
+    {
+        const Direction push_dir = stm() == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
+        const BitBoard  captured = shift(to, push_dir.reverse()).to_bb();
+        const BitBoard  occ_after = (occ ^ from.to_bb() ^ captured) | to.to_bb();
+
+        return !(attackers_to(ksq, occ_after) & them & ~captured);
+    }
+
+    if (checkers_)
+    {
+        if (checkers_.popcount() > 1)
+            return false;
+
+        const Square checker = Square::from_ordinal(checkers_.lsb());
+
+        if (!((Attacks::between(ksq, checker) | checkers_) & to.to_bb()))
+            return false;
+    }
+
+    return !(blockers_for_king(stm()) & from.to_bb()) || (Attacks::line(from, ksq) & to.to_bb());
+}
+
+// Whether the side to move holds the right for `path`, the squares between king and rook are empty
+// and the king does not start in, pass through or land in check.
+bool PositionState::can_castle(const Detail::CastlingPath& path) const noexcept {
+    if (!(castling_rights_ & path.right))
+        return false;
+
+    const BitBoard occ = bb(Color::WHITE(), Color::BLACK());
+
+    if (occ & path.empty)
+        return false;
+
+    BitBoard safe = path.safe;
+    while (safe)
+    {
+        if (attackers_to(Square::from_ordinal(safe.pop_lsb()), occ) & bb(~stm()))
+            return false;
+    }
+
+    return true;
+}
 
 bool PositionState::is_ok() const noexcept {
     const BitBoard king_bb = bb(Piece::make(PieceType::KING(), ~stm()));
@@ -110,6 +402,11 @@ bool PositionState::is_ok() const noexcept {
         return false;
     }
 
+    if (Attacks::king_attacks(ksq) & bb(Piece::make(PieceType::KING(), stm())))
+    {
+        return false;
+    }
+
     const BitBoard occ = bb(Color::WHITE(), Color::BLACK());
 
     if (Attacks::bishop_attacks(ksq, occ)
@@ -127,6 +424,308 @@ bool PositionState::is_ok() const noexcept {
     return true;
 }
 
+namespace {
+
+// The least valuable piece type among `attackers`, which must not be empty.
+PieceType least_valuable(const PositionState& pos, const BitBoard attackers) noexcept {
+    for (std::size_t i = 0; i < PieceType::COUNT() - 1; i++)
+        if (attackers & pos.bb(PieceType::from_ordinal(i)))
+            return PieceType::from_ordinal(i);
+
+    return PieceType::KING();
+}
+
+// Sliders that see `square` through the piece of type `taken_with` that just left `occ`.
+BitBoard xray_attackers(const PositionState& pos,
+                        const PieceType      taken_with,
+                        const Square         square,
+                        const BitBoard       occ) noexcept {
+    BitBoard xrays;
+
+    if (taken_with == PieceType::PAWN() || taken_with == PieceType::BISHOP()
+        || taken_with == PieceType::QUEEN())
+        xrays |= Attacks::bishop_attacks(square, occ)
+               & pos.bb(PieceType::BISHOP(), PieceType::QUEEN());
+
+    if (taken_with == PieceType::ROOK() || taken_with == PieceType::QUEEN())
+        xrays |= Attacks::rook_attacks(square, occ) & pos.bb(PieceType::ROOK(), PieceType::QUEEN());
+
+    return xrays;
+}
+
+// Squares attacked by a non-pawn piece of type `piece_type` on `square`.
+BitBoard piece_attacks(const PieceType piece_type, const Square square, const BitBoard occ) {
+    switch (piece_type.to_underlying())
+    {
+    case PieceType::KNIGHT().to_underlying() :
+        return Attacks::knight_attacks(square);
+    case PieceType::BISHOP().to_underlying() :
+        return Attacks::bishop_attacks(square, occ);
+    case PieceType::ROOK().to_underlying() :
+        return Attacks::rook_attacks(square, occ);
+    case PieceType::QUEEN().to_underlying() :
+        return Attacks::queen_attacks(square, occ);
+    default :
+        return Attacks::king_attacks(square);
+    }
+}
+
+std::int32_t see_value(const Piece piece) noexcept {
+    return piece.is_valid() ? SeeValues[piece.type().to_underlying()] : 0;
+}
+
+}  // namespace
+
+// Whether the pseudo-legal `move` checks the enemy king. Ordinary moves only need the cached check
+// squares and blockers; castling, promotions and en passant move or remove a second piece and are
+// tested against the occupancy after the move.
+bool PositionState::gives_check(const Move move) const noexcept {
+    const Square   from   = move.from();
+    const Square   to     = move.to();
+    const Square   ksq    = king_square(~stm());
+    const BitBoard ksq_bb = ksq.to_bb();
+
+    if (move.is_castling())
+    {
+        const Detail::CastlingPath& path = Castling::path(stm(), to);
+        const BitBoard occ = (bb(Color::WHITE(), Color::BLACK()) ^ path.king_from.to_bb()
+                              ^ path.rook_from.to_bb())
+                           | path.king_to.to_bb() | path.rook_to.to_bb();
+
+        return static_cast<bool>(Attacks::rook_attacks(path.rook_to, occ) & ksq_bb);
+    }
+
+    const BitBoard occ = (bb(Color::WHITE(), Color::BLACK()) ^ from.to_bb()) | to.to_bb();
+
+    if (move.is_promotion())
+    {
+        if (piece_attacks(move.promtion_piece(), to, occ) & ksq_bb)
+            return true;
+    }
+    else if (check_squares(piece_on(from).type()) & to.to_bb())
+        return true;
+
+    // A blocker that leaves the line to the enemy king uncovers a check.
+    if ((blockers_for_king(~stm()) & from.to_bb()) && !(Attacks::line(from, ksq) & to.to_bb()))
+        return true;
+
+    if (move.is_ep())
+    {
+        const Direction push_dir = stm() == Color::WHITE() ? Direction::NORTH() : Direction::SOUTH();
+        const BitBoard  occ_after = occ ^ shift(to, push_dir.reverse()).to_bb();
+
+        return static_cast<bool>(
+          ((Attacks::bishop_attacks(ksq, occ_after) & bb(PieceType::BISHOP(), PieceType::QUEEN()))
+           | (Attacks::rook_attacks(ksq, occ_after) & bb(PieceType::ROOK(), PieceType::QUEEN())))
+          & bb(stm()));
+    }
+
+    return false;
+}
+
+// Material won by `move` once the exchange on its destination has played out, both sides always
+// recapturing with their least valuable attacker and free to stop when that stops paying. The
+// occupancy shrinks as pieces are used up, so sliders lined up behind them join in. A king only
+// recaptures onto an undefended square. En passant, promotions and castling are scored as 0.
+std::int32_t PositionState::see(const Move move) const noexcept {
+    if (move.is_ep() || move.is_promotion() || move.is_castling())
+        return 0;
+
+    const Square from = move.from();
+    const Square to   = move.to();
+
+    std::array<std::int32_t, 32> gain;
+    std::size_t                  depth = 0;
+
+    BitBoard     occ       = bb(Color::WHITE(), Color::BLACK()) ^ from.to_bb();
+    BitBoard     attackers = attackers_to(to, occ) & occ;
+    Color        side      = ~stm();
+    std::int32_t on_square = see_value(piece_on(from));
+
+    gain[0] = see_value(piece_on(to));
+
+    while (const BitBoard side_attackers = attackers & bb(side))
+    {
+        const PieceType pt = least_valuable(*this, side_attackers);
+
+        if (pt == PieceType::KING() && (attackers & bb(~side)))
+            break;
+
+        depth++;
+        gain[depth] = on_square - gain[depth - 1];
+        on_square   = SeeValues[pt.to_underlying()];
+
+        occ ^= Square::from_ordinal((side_attackers & bb(pt)).lsb()).to_bb();
+        attackers = (attackers | xray_attackers(*this, pt, to, occ)) & occ;
+        side      = ~side;
+    }
+
+    while (depth > 0)
+    {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+
+    return gain[0];
+}
+
+// Whether see(move) >= threshold, without playing out the whole exchange: `swap` tracks how far
+// the side that just captured is ahead of the threshold, and the loop stops as soon as the side to
+// recapture cannot change the outcome.
+bool PositionState::see_ge(const Move move, std::int32_t threshold) const noexcept {
+    if (move.is_ep() || move.is_promotion() || move.is_castling())
+        return 0 >= threshold;
+
+    const Square from = move.from();
+    const Square to   = move.to();
+
+    std::int32_t swap = see_value(piece_on(to)) - threshold;
+    if (swap < 0)
+        return false;
+
+    swap = see_value(piece_on(from)) - swap;
+    if (swap <= 0)
+        return true;
+
+    BitBoard     occ       = bb(Color::WHITE(), Color::BLACK()) ^ from.to_bb();
+    BitBoard     attackers = attackers_to(to, occ) & occ;
+    Color        side      = stm();
+    std::int32_t result    = 1;
+
+    while (true)
+    {
+        side = ~side;
+
+        const BitBoard side_attackers = attackers & bb(side);
+        if (!side_attackers)
+            break;
+
+        result ^= 1;
+
+        const PieceType pt = least_valuable(*this, side_attackers);
+
+        // Recapturing with the king only works if the other side has nothing left to recapture.
+        if (pt == PieceType::KING())
+            return (attackers & bb(~side)) ? !result : result;
+
+        swap = SeeValues[pt.to_underlying()] - swap;
+        if (swap < result)
+            break;
+
+        occ ^= Square::from_ordinal((side_attackers & bb(pt)).lsb()).to_bb();
+        attackers = (attackers | xray_attackers(*this, pt, to, occ)) & occ;
+    }
+
+    return result;
+}
+
+void PositionState::update_check_info() noexcept {
+    const BitBoard occ = bb(Color::WHITE(), Color::BLACK());
+    const Square   ksq = king_square(~stm());
+
+    checkers_ = attackers_to(king_square(stm()), occ) & bb(~stm());
+
+    update_blockers(Color::WHITE());
+    update_blockers(Color::BLACK());
+
+    const BitBoard pawn   = Attacks::pawn_attacks(ksq.to_bb(), ~stm());
+    const BitBoard bishop = Attacks::bishop_attacks(ksq, occ);
+    const BitBoard rook   = Attacks::rook_attacks(ksq, occ);
+
+    check_squares_[PieceType::PAWN().to_underlying()]   = pawn;
+    check_squares_[PieceType::KNIGHT().to_underlying()] = Attacks::knight_attacks(ksq);
+    check_squares_[PieceType::BISHOP().to_underlying()] = bishop;
+    check_squares_[PieceType::ROOK().to_underlying()]   = rook;
+    check_squares_[PieceType::QUEEN().to_underlying()]  = bishop | rook;
+    check_squares_[PieceType::KING().to_underlying()]   = 0ULL;
+}
+
+// Enemy sliders aimed at `color`'s king on an empty board, with exactly one piece in between, pin
+// that piece if it is `color`'s and can uncover check with it if it is their own.
+void PositionState::update_blockers(const Color color) noexcept {
+    const Square   ksq = king_square(color);
+    const BitBoard occ = bb(Color::WHITE(), Color::BLACK());
+
+    BitBoard snipers =
+      ((Attacks::bishop_attacks(ksq, 0ULL) & bb(PieceType::BISHOP(), PieceType::QUEEN()))
+       | (Attacks::rook_attacks(ksq, 0ULL) & bb(PieceType::ROOK(), PieceType::QUEEN())))
+      & bb(~color);
+
+    BitBoard blockers{};
+    BitBoard pinners{};
+
+    while (snipers)
+    {
+        const Square   sniper  = Square::from_ordinal(snipers.pop_lsb());
+        const BitBoard between = Attacks::between(ksq, sniper) & occ;
+
+        if (between.popcount() == 1)
+        {
+            blockers |= between;
+
+            if (between & bb(color))
+                pinners |= sniper.to_bb();
+        }
+    }
+
+    blockers_for_king_[color.to_underlying()] = blockers;
+    pinners_[(~color).to_underlying()]        = pinners;
+}
+
+void PositionState::refresh_keys() noexcept {
+    key_          = compute_key();
+    pawn_key_     = compute_pawn_key();
+    material_key_ = compute_material_key();
+}
+
+std::uint64_t PositionState::compute_key() const noexcept {
+    std::uint64_t key = 0;
+    BitBoard      occ = bb(Color::WHITE(), Color::BLACK());
+
+    while (occ)
+    {
+        const Square sq = Square::from_ordinal(occ.pop_lsb());
+        key ^= Zobrist::piece_square(piece_on(sq), sq);
+    }
+
+    if (en_passant_destination_.is_valid())
+        key ^= Zobrist::en_passant(en_passant_destination_.file());
+
+    key ^= Zobrist::castling(castling_rights_);
+
+    if (side_to_move == Color::BLACK())
+        key ^= Zobrist::side();
+
+    return key;
+}
+
+std::uint64_t PositionState::compute_pawn_key() const noexcept {
+    std::uint64_t key   = 0;
+    BitBoard      pawns = bb(PieceType::PAWN());
+
+    while (pawns)
+    {
+        const Square sq = Square::from_ordinal(pawns.pop_lsb());
+        key ^= Zobrist::piece_square(piece_on(sq), sq);
+    }
+
+    return key;
+}
+
+std::uint64_t PositionState::compute_material_key() const noexcept {
+    std::uint64_t key = 0;
+
+    for (std::size_t piece_idx = 0; piece_idx < PieceType::COUNT() * Color::COUNT(); piece_idx++)
+    {
+        const Piece piece = Piece::from_ordinal(piece_idx);
+
+        for (int count = 0; count < bb(piece).popcount(); count++)
+            key ^= Zobrist::piece_square(piece, Square::from_ordinal(count));
+    }
+
+    return key;
+}
+
 std::ostream& operator<<(std::ostream& os, const PositionState& pos) {
     os << " +---+---+---+---+---+---+---+---+\n";
 
@@ -145,4 +744,29 @@ std::ostream& operator<<(std::ostream& os, const PositionState& pos) {
     return os;
 }
 
+Score PositionState::compute_psqt() const noexcept {
+    Score    score{};
+    BitBoard occ = bb(Color::WHITE(), Color::BLACK());
+
+    while (occ)
+    {
+        const Square sq = Square::from_ordinal(occ.pop_lsb());
+        score += Psqt::score(piece_on(sq), sq);
+    }
+
+    return score;
+}
+
+std::int32_t PositionState::compute_phase() const noexcept {
+    std::int32_t phase = 0;
+
+    for (std::size_t pt_idx = 0; pt_idx < PieceType::COUNT(); pt_idx++)
+    {
+        const PieceType piece_type = PieceType::from_ordinal(pt_idx);
+        phase += Psqt::phase(piece_type) * bb(piece_type).popcount();
+    }
+
+    return phase;
+}
+
 }
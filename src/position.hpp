@@ -2,32 +2,92 @@
 #define VOLTA_POSITION_HPP__
 
 #include <array>
+#include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstdint>
 #include <iostream>
 #include <string_view>
 
 #include "bbmanip.hpp"
 #include "bitboard.hpp"
+#include "castling.hpp"
 #include "common.hpp"
 #include "coordinates.hpp"
 #include "move.hpp"
 #include "piece.hpp"
+#include "psqt.hpp"
 
 namespace Volta::Chess {
 
+// Piece values for static exchange evaluation. The king is never given up, so it is worth nothing.
+inline constexpr std::array<std::int32_t, PieceType::COUNT()> SeeValues = {100, 320, 330,
+                                                                          500, 900, 0};
+
+// Everything make_move destroys that cannot be recovered from the move itself. The hashes and the
+// check information are restored wholesale rather than re-XORed or recomputed on the way back.
+struct UndoInfo {
+    Piece          captured;
+    Square         en_passant_destination;
+    std::uint8_t   rule50;
+    CastlingRights castling_rights;
+    std::uint64_t  key;
+    std::uint64_t  pawn_key;
+    std::uint64_t  material_key;
+
+    BitBoard                                 checkers;
+    std::array<BitBoard, Color::COUNT()>     blockers_for_king;
+    std::array<BitBoard, Color::COUNT()>     pinners;
+    std::array<BitBoard, PieceType::COUNT()> check_squares;
+};
+
+// Pieces placed and lifted by the last make_move, for evaluation terms that are updated
+// incrementally outside the position. A move lifts at most two pieces and places at most two.
+struct DirtyPieces {
+    struct Entry {
+        Piece  piece;
+        Square square;
+    };
+
+    std::array<Entry, 2> added;
+    std::array<Entry, 2> removed;
+    std::uint8_t         added_count;
+    std::uint8_t         removed_count;
+};
+
 struct PositionState {
    private:
-    Square       en_passant_destination_;
-    std::uint8_t rule50;
-    Color        side_to_move;
+    Square         en_passant_destination_;
+    std::uint8_t   rule50;
+    Color          side_to_move;
+    CastlingRights castling_rights_;
+    std::uint64_t  key_;
+    std::uint64_t  pawn_key_;
+    std::uint64_t  material_key_;
+    Score          psqt_;
+    std::int32_t   phase_;
+    DirtyPieces    dirty_pieces_;
 
     std::array<BitBoard, Color::COUNT()>     by_color;
     std::array<BitBoard, PieceType::COUNT()> by_piece_type;
     std::array<Piece, Square::COUNT()>       mailbox;
 
+    // Check information, recomputed by make_move and restored by unmake_move. Blockers are the
+    // pieces of either color that alone stand between a king and an enemy slider, pinners the
+    // sliders behind those blockers, and check squares where each piece type of the side to move
+    // would attack the enemy king.
+    BitBoard                                 checkers_;
+    std::array<BitBoard, Color::COUNT()>     blockers_for_king_;
+    std::array<BitBoard, Color::COUNT()>     pinners_;
+    std::array<BitBoard, PieceType::COUNT()> check_squares_;
+
+    template<bool UpdateKeys = true>
     void add_piece(const Piece piece, const Square square) noexcept;
+    template<bool UpdateKeys = true>
     void remove_piece(const Piece piece, const Square square) noexcept;
+    void refresh_keys() noexcept;
+    void update_check_info() noexcept;
+    void update_blockers(const Color color) noexcept;
 
    public:
     constexpr PositionState& operator=(const PositionState& other) = default;
@@ -36,16 +96,40 @@ struct PositionState {
         en_passant_destination_{},
         rule50{},
         side_to_move{Color::WHITE()},
+        castling_rights_{},
+        key_{},
+        pawn_key_{},
+        material_key_{},
+        psqt_{},
+        phase_{},
+        dirty_pieces_{},
         by_color{},
         by_piece_type{},
-        mailbox{} {};
-
-    Piece piece_on(const Square square) const noexcept;
-    void  make_move(const Move move) noexcept;
-    bool  is_legal(const Move move) const noexcept;
-    bool  is_ok() const noexcept;
-
-    static constexpr PositionState from_fen(std::string_view fen) noexcept {
+        mailbox{},
+        checkers_{},
+        blockers_for_king_{},
+        pinners_{},
+        check_squares_{} {};
+
+    Piece         piece_on(const Square square) const noexcept;
+    BitBoard      attackers_to(const Square square, const BitBoard occ) const noexcept;
+    void          make_move(const Move move) noexcept;
+    void          make_move(const Move move, UndoInfo& undo) noexcept;
+    void          unmake_move(const Move move, const UndoInfo& undo) noexcept;
+    bool          is_pseudo_legal(const Move move) const noexcept;
+    bool          is_legal(const Move move) const noexcept;
+    bool          can_castle(const Detail::CastlingPath& path) const noexcept;
+    bool          is_ok() const noexcept;
+    bool          gives_check(const Move move) const noexcept;
+    std::int32_t  see(const Move move) const noexcept;
+    bool          see_ge(const Move move, std::int32_t threshold) const noexcept;
+    std::uint64_t compute_key() const noexcept;
+    std::uint64_t compute_pawn_key() const noexcept;
+    std::uint64_t compute_material_key() const noexcept;
+    Score         compute_psqt() const noexcept;
+    std::int32_t  compute_phase() const noexcept;
+
+    static PositionState from_fen(std::string_view fen) noexcept {
         PositionState ret{};
 
         constexpr std::string_view    delim  = " ";
@@ -85,12 +169,20 @@ struct PositionState {
             assert(false && "Fen parsing error: invalid side");
         }
 
+        ret.castling_rights_        = CastlingRights::from_string(slices[2]);
         ret.en_passant_destination_ = Square::from_string(slices[3]);
 
+        std::int32_t halfmoves = 0;
+        std::from_chars(slices[4].data(), slices[4].data() + slices[4].size(), halfmoves);
+        ret.rule50 = static_cast<std::uint8_t>(std::clamp(halfmoves, 0, 255));
+
+        ret.refresh_keys();
+        ret.update_check_info();
+
         return ret;
     }
 
-    static constexpr PositionState startpos() noexcept {
+    static PositionState startpos() noexcept {
         return PositionState::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
     }
 
@@ -113,7 +205,46 @@ struct PositionState {
 
     constexpr Color stm() const noexcept { return side_to_move; }
 
+    constexpr Square king_square(const Color color) const noexcept {
+        return Square::from_ordinal(bb(Piece::make(PieceType::KING(), color)).lsb());
+    }
+
     constexpr Square en_passant_destination() const noexcept { return en_passant_destination_; };
+
+    constexpr CastlingRights castling_rights() const noexcept { return castling_rights_; }
+
+    // Plies since the last capture or pawn move.
+    constexpr std::int32_t halfmove_clock() const noexcept { return rule50; }
+
+    // Zobrist hash of the full position, of the pawns alone, and of the piece counts.
+    constexpr std::uint64_t key() const noexcept { return key_; }
+    constexpr std::uint64_t pawn_key() const noexcept { return pawn_key_; }
+    constexpr std::uint64_t material_key() const noexcept { return material_key_; }
+
+    // Material and piece-square score from White's point of view, and the game phase, both kept
+    // up to date by add_piece and remove_piece.
+    constexpr Score        psqt() const noexcept { return psqt_; }
+    constexpr std::int32_t phase() const noexcept { return phase_; }
+
+    constexpr const DirtyPieces& dirty_pieces() const noexcept { return dirty_pieces_; }
+
+    // Enemy pieces giving check to the side to move.
+    constexpr BitBoard checkers() const noexcept { return checkers_; }
+    constexpr bool     in_check() const noexcept { return static_cast<bool>(checkers_); }
+
+    // Pieces of either color that alone shield `color`'s king from an enemy slider, and the
+    // sliders of `color` that pin an enemy piece to the enemy king.
+    constexpr BitBoard blockers_for_king(const Color color) const noexcept {
+        return blockers_for_king_[color.to_underlying()];
+    }
+    constexpr BitBoard pinners(const Color color) const noexcept {
+        return pinners_[color.to_underlying()];
+    }
+
+    // Squares from which a piece of `piece_type` belonging to the side to move would give check.
+    constexpr BitBoard check_squares(const PieceType piece_type) const noexcept {
+        return check_squares_[piece_type.to_underlying()];
+    }
 };
 
 std::ostream& operator<<(std::ostream& os, const PositionState& pos);
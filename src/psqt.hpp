@@ -0,0 +1,142 @@
+#ifndef VOLTA_PSQT_HPP__
+#define VOLTA_PSQT_HPP__
+
+#include <array>
+#include <cstdint>
+
+#include "common.hpp"
+#include "coordinates.hpp"
+#include "piece.hpp"
+
+namespace Volta::Chess {
+
+// A midgame and an endgame value packed into one integer, so that both halves are updated with a
+// single add. The endgame half sits in the upper 16 bits; a negative midgame half borrows from it,
+// which eg() undoes by rounding.
+class Score {
+   private:
+    std::int32_t score;
+
+    constexpr explicit Score(std::int32_t packed) :
+        score{packed} {}
+
+   public:
+    constexpr Score() :
+        score{0} {}
+
+    static constexpr Score make(std::int32_t mg, std::int32_t eg) noexcept {
+        return Score(static_cast<std::int32_t>(static_cast<std::uint32_t>(eg) << 16) + mg);
+    }
+
+    constexpr std::int32_t mg() const noexcept {
+        return static_cast<std::int16_t>(static_cast<std::uint16_t>(score));
+    }
+
+    constexpr std::int32_t eg() const noexcept {
+        return static_cast<std::int16_t>(
+          static_cast<std::uint16_t>((static_cast<std::uint32_t>(score) + 0x8000) >> 16));
+    }
+
+    constexpr bool operator==(const Score& other) const noexcept { return score == other.score; }
+
+    constexpr Score operator+(const Score rhs) const noexcept { return Score(score + rhs.score); }
+    constexpr Score operator-(const Score rhs) const noexcept { return Score(score - rhs.score); }
+    constexpr Score operator-() const noexcept { return Score(-score); }
+    constexpr Score operator*(std::int32_t rhs) const noexcept { return Score(score * rhs); }
+
+    constexpr Score& operator+=(const Score rhs) noexcept { return *this = *this + rhs; }
+    constexpr Score& operator-=(const Score rhs) noexcept { return *this = *this - rhs; }
+};
+
+namespace Detail {
+
+// Per piece type: material, plus a bonus by rank (from the owner's side) and by distance-to-edge
+// file (a/h, b/g, c/f, d/e), for each game phase. A square's value is material + rank + file.
+struct PsqtParameters {
+    Score                material;
+    std::array<Score, 8> rank;
+    std::array<Score, 4> file;
+    std::int32_t         phase;
+};
+
+constexpr Score S(std::int32_t mg, std::int32_t eg) { return Score::make(mg, eg); }
+
+// clang-format off
+inline constexpr std::array<PsqtParameters, PieceType::COUNT()> PsqtParams = {{
+  // Pawn
+  {S(82, 94),
+   {S(0, 0), S(-5, -10), S(-2, -5), S(5, 5), S(12, 20), S(25, 45), S(50, 90), S(0, 0)},
+   {S(-5, 0), S(0, 0), S(5, 0), S(10, 0)}, 0},
+  // Knight
+  {S(337, 281),
+   {S(-25, -20), S(-10, -10), S(0, 0), S(10, 10), S(15, 10), S(20, 5), S(10, 0), S(-20, -20)},
+   {S(-25, -20), S(-5, -5), S(5, 5), S(10, 10)}, 1},
+  // Bishop
+  {S(365, 297),
+   {S(-10, -10), S(0, -5), S(5, 0), S(5, 5), S(5, 5), S(5, 0), S(0, -5), S(-10, -10)},
+   {S(-5, -10), S(0, -5), S(5, 0), S(5, 5)}, 1},
+  // Rook
+  {S(477, 512),
+   {S(0, -5), S(0, -5), S(-5, 0), S(-5, 0), S(0, 5), S(5, 5), S(20, 10), S(10, 5)},
+   {S(-5, 0), S(0, 0), S(5, 0), S(10, 0)}, 2},
+  // Queen
+  {S(1025, 936),
+   {S(-10, -20), S(0, -10), S(0, 0), S(0, 10), S(5, 15), S(5, 15), S(0, 10), S(-5, 0)},
+   {S(-10, -20), S(0, -5), S(5, 5), S(5, 10)}, 4},
+  // King
+  {S(0, 0),
+   {S(20, -30), S(0, -10), S(-20, 0), S(-30, 10),
+    S(-40, 20), S(-50, 20), S(-50, 10), S(-50, -10)},
+   {S(20, -30), S(30, -10), S(0, 10), S(-20, 20)}, 0}}};
+// clang-format on
+
+using PsqtTable =
+  std::array<std::array<Score, Square::COUNT()>, PieceType::COUNT() * Color::COUNT()>;
+
+// White's values are read straight from the parameters; black's are the same squares mirrored
+// vertically and negated, so the table sums to White's point of view.
+consteval PsqtTable generate_psqt() {
+    PsqtTable table{};
+
+    for (std::size_t pt_idx = 0; pt_idx < PieceType::COUNT(); pt_idx++)
+    {
+        const PsqtParameters& params = PsqtParams[pt_idx];
+        const PieceType       type   = PieceType::from_ordinal(pt_idx);
+
+        for (std::size_t sq_idx = 0; sq_idx < Square::COUNT(); sq_idx++)
+        {
+            const std::size_t file  = sq_idx % 8;
+            const std::size_t rank  = sq_idx / 8;
+            const Score       score = params.material + params.rank[rank]
+                                + params.file[file < 4 ? file : 7 - file];
+
+            table[Piece::make(type, Color::WHITE()).to_underlying()][sq_idx]      = score;
+            table[Piece::make(type, Color::BLACK()).to_underlying()][sq_idx ^ 56] = -score;
+        }
+    }
+
+    return table;
+}
+
+}
+
+class Psqt {
+   private:
+    static constexpr Detail::PsqtTable Table = Detail::generate_psqt();
+
+   public:
+    // Game phase of the full starting material; promotions can push a position above it.
+    static constexpr std::int32_t MAX_PHASE() noexcept { return 24; }
+
+    static constexpr Score score(const Piece piece, const Square sq) noexcept {
+        return Table[piece.to_underlying()][sq.ordinal()];
+    }
+
+    static constexpr std::int32_t phase(const PieceType piece_type) noexcept {
+        return Detail::PsqtParams[piece_type.to_underlying()].phase;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,583 @@
+#include "search.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "attacks.hpp"
+#include "uci.hpp"
+
+namespace Volta::Engine {
+
+namespace {
+
+// Largest history bonus from a single cutoff.
+constexpr std::int32_t HISTORY_BONUS_MAX = 1200;
+
+// How often, in nodes, the main thread reads the clock. Between reads it only decrements a counter,
+// so steady_clock stays out of the profile.
+constexpr std::uint64_t CHECK_INTERVAL = 1024;
+
+// Helper depth schedules: helper i searches depth d unless ((d + phase) / size) is odd.
+constexpr std::array<std::int32_t, 20> SKIP_SIZE  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                                     3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+constexpr std::array<std::int32_t, 20> SKIP_PHASE = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3,
+                                                     4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+// Mate scores are stored relative to the node rather than the root.
+Value value_to_tt(Value value, std::int32_t ply) {
+    if (value >= VALUE_MATE_IN_MAX_PLY)
+        return value + ply;
+
+    if (value <= -VALUE_MATE_IN_MAX_PLY)
+        return value - ply;
+
+    return value;
+}
+
+Value value_from_tt(Value value, std::int32_t ply) {
+    if (value >= VALUE_MATE_IN_MAX_PLY)
+        return value - ply;
+
+    if (value <= -VALUE_MATE_IN_MAX_PLY)
+        return value + ply;
+
+    return value;
+}
+
+// Every thread votes for its best move, weighted by how deep it searched and by how far its score
+// is above the worst thread's. Threads stopped before finishing an iteration have no score and do
+// not vote. The main thread wins ties.
+Move vote(const std::vector<std::unique_ptr<Search>>& searches) {
+    Value min_score = VALUE_INFINITE;
+
+    for (const auto& search : searches)
+        if (search->completed_depth() > 0)
+            min_score = std::min(min_score, search->best_score());
+
+    Move         best_move  = searches[0]->best_move();
+    std::int64_t best_votes = -1;
+
+    for (const auto& candidate : searches)
+    {
+        if (candidate->completed_depth() == 0)
+            continue;
+
+        std::int64_t votes = 0;
+
+        for (const auto& search : searches)
+            if (search->completed_depth() > 0 && search->best_move() == candidate->best_move())
+                votes += std::int64_t{search->best_score() - min_score + 14}
+                       * search->completed_depth();
+
+        if (votes > best_votes)
+        {
+            best_move  = candidate->best_move();
+            best_votes = votes;
+        }
+    }
+
+    return best_move;
+}
+
+}  // namespace
+
+SharedSearchState::SharedSearchState(const PositionState&              root,
+                                     const std::vector<std::uint64_t>& game_history,
+                                     const SearchLimits&               search_limits,
+                                     const std::atomic<bool>&          stop_flag,
+                                     TranspositionTable&               table,
+                                     const Network*                    nnue,
+                                     std::size_t                       thread_count,
+                                     bool                              verbose_output) :
+    history{game_history},
+    limits{search_limits},
+    stop{stop_flag},
+    tt{table},
+    network{nnue},
+    abort{false},
+    threads{thread_count},
+    counters{std::make_unique<NodeCounter[]>(thread_count)},
+    verbose{verbose_output},
+    time{search_limits, root.stm()} {}
+
+std::uint64_t SharedSearchState::total_nodes() const noexcept {
+    std::uint64_t total = 0;
+
+    for (std::size_t i = 0; i < threads; i++)
+        total += counters[i].nodes.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+ThreadData::ThreadData() { clear(); }
+
+void ThreadData::clear() {
+    history              = {};
+    continuation_history = {};
+
+    for (auto& moves : counter_moves)
+        moves.fill(Move::NONE());
+}
+
+Search::Search(const PositionState& root,
+               SharedSearchState&   shared_state,
+               ThreadData&          data,
+               std::size_t          id) :
+    shared{shared_state},
+    tt{shared_state.tt},
+    thread_id{id},
+    counter{shared_state.counters[id]},
+    nodes{0},
+    poll_countdown{CHECK_INTERVAL},
+    stopped{false},
+    best_move_{Move::NONE()},
+    best_score_{-VALUE_INFINITE},
+    completed_depth_{0},
+    previous_pv_length{0},
+    history{data.history},
+    continuation_history{data.continuation_history},
+    counter_moves{data.counter_moves},
+    pawn_table{data.pawn_table} {
+    stack[0].pos       = root;
+    stack[0].pv_length = 0;
+
+    for (StackEntry& entry : stack)
+        entry.killers = {Move::NONE(), Move::NONE()};
+
+    if (shared.network)
+        shared.network->refresh(root, stack[0].acc);
+}
+
+void Search::run() {
+    const SearchLimits& limits = shared.limits;
+
+    MoveList root_moves;
+    append_legal_moves(root_moves, stack[0].pos);
+
+    if (root_moves.empty())
+        return;
+
+    best_move_ = root_moves[0];
+
+    const std::int32_t max_depth = limits.depth > 0 ? std::min(limits.depth, MAX_PLY - 1)
+                                                    : MAX_PLY - 1;
+
+    // Iterations in a row that kept the same best move.
+    std::int32_t stability = 0;
+
+    for (std::int32_t depth = 1; depth <= max_depth; depth++)
+    {
+        if (skip_depth(depth))
+            continue;
+
+        const Value score = negamax(depth, 0, -VALUE_INFINITE, VALUE_INFINITE);
+
+        // An interrupted iteration is only trusted if nothing better is available.
+        if (stopped && completed_depth_ > 0)
+            break;
+
+        if (stack[0].pv_length > 0)
+        {
+            stability = completed_depth_ > 0 && stack[0].pv[0] == best_move_ ? stability + 1 : 0;
+
+            best_move_         = stack[0].pv[0];
+            best_score_        = score;
+            completed_depth_   = depth;
+            previous_pv        = stack[0].pv;
+            previous_pv_length = stack[0].pv_length;
+        }
+
+        if (thread_id == 0)
+            report(depth, score);
+
+        if (stopped || (thread_id == 0 && shared.time.soft_limit_reached(stability)))
+            break;
+    }
+
+    // `go infinite` must not answer before it is told to stop. Helpers keep searching meanwhile.
+    while (thread_id == 0 && limits.infinite && !shared.stop.load(std::memory_order_relaxed))
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+Value Search::negamax(std::int32_t depth, std::int32_t ply, Value alpha, Value beta) {
+    stack[ply].pv_length = 0;
+
+    if (depth <= 0)
+        return qsearch(ply, alpha, beta);
+
+    if (ply > 0 && should_stop())
+        return 0;
+
+    if (ply > 0 && is_draw(ply))
+        return VALUE_DRAW;
+
+    const PositionState& pos        = stack[ply].pos;
+    const bool           checked    = pos.in_check();
+    const bool           pv_node    = beta - alpha > 1;
+    const Value          alpha_orig = alpha;
+
+    if (ply >= MAX_PLY - 1)
+        return static_eval(ply);
+
+    TTData     tt_data;
+    const bool tt_hit  = tt.probe(pos.key(), tt_data);
+    const Move tt_move = tt_hit && pos.is_pseudo_legal(tt_data.move) ? tt_data.move : Move::NONE();
+
+    if (!pv_node && tt_hit && tt_data.depth >= depth)
+    {
+        const Value tt_value = value_from_tt(tt_data.value, ply);
+
+        if (tt_data.bound == Bound::EXACT || (tt_data.bound == Bound::LOWER && tt_value >= beta)
+            || (tt_data.bound == Bound::UPPER && tt_value <= alpha))
+            return tt_value;
+    }
+
+    if (checked)
+        depth++;
+
+    const Move pv_move  = ply < previous_pv_length ? previous_pv[ply] : Move::NONE();
+    const Move previous = ply > 0 ? stack[ply - 1].move : Move::NONE();
+
+    const std::array<const PieceToHistory*, 2> continuation = {
+      ply > 0 ? stack[ply - 1].continuation : nullptr,
+      ply > 1 ? stack[ply - 2].continuation : nullptr};
+
+    MovePicker picker(
+      pos, tt_move != Move::NONE() ? tt_move : pv_move, stack[ply].killers,
+      ply > 0 ? counter_moves[stack[ply - 1].moved.to_underlying()][previous.to().ordinal()]
+              : Move::NONE(),
+      history, continuation, checked);
+
+    Value       best      = -VALUE_INFINITE;
+    Move        best_move = Move::NONE();
+    std::size_t legal     = 0;
+    QuietList   quiets_tried;
+
+    for (Move move = picker.next(); move != Move::NONE(); move = picker.next())
+    {
+        if (!play(move, ply))
+            continue;
+
+        legal++;
+
+        Value score;
+
+        if (legal == 1)
+            score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        else
+        {
+            score = -negamax(depth - 1, ply + 1, -alpha - 1, -alpha);
+
+            if (score > alpha && score < beta)
+                score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        }
+
+        if (stopped)
+            return 0;
+
+        if (score > best)
+        {
+            best = score;
+
+            if (score > alpha)
+            {
+                alpha     = score;
+                best_move = move;
+                update_pv(move, ply);
+
+                if (alpha >= beta)
+                {
+                    if (is_quiet(move))
+                        update_quiet_stats(ply, depth, move, quiets_tried);
+
+                    break;
+                }
+            }
+        }
+
+        if (is_quiet(move) && quiets_tried.size() < QuietList::capacity())
+            quiets_tried.push_back(move);
+    }
+
+    if (legal == 0)
+        return checked ? -VALUE_MATE + ply : VALUE_DRAW;
+
+    const Bound bound = best >= beta         ? Bound::LOWER
+                      : best > alpha_orig    ? Bound::EXACT
+                                             : Bound::UPPER;
+
+    tt.store(pos.key(), best_move, value_to_tt(best, ply), VALUE_NONE, depth, bound);
+
+    return best;
+}
+
+Value Search::qsearch(std::int32_t ply, Value alpha, Value beta) {
+    stack[ply].pv_length = 0;
+
+    if (should_stop())
+        return 0;
+
+    const PositionState& pos       = stack[ply].pos;
+    const Value          stand_pat = static_eval(ply);
+
+    if (ply >= MAX_PLY - 1 || stand_pat >= beta)
+        return stand_pat;
+
+    alpha = std::max(alpha, stand_pat);
+
+    MovePicker picker(pos);
+    Value      best = stand_pat;
+
+    for (Move move = picker.next(); move != Move::NONE(); move = picker.next())
+    {
+        // A capture that loses material in the exchange will not raise the stand-pat score.
+        if (!pos.see_ge(move, 0))
+            continue;
+
+        if (!play(move, ply))
+            continue;
+
+        const Value score = -qsearch(ply + 1, -beta, -alpha);
+
+        if (stopped)
+            return 0;
+
+        if (score > best)
+        {
+            best = score;
+
+            if (score > alpha)
+            {
+                alpha = score;
+                update_pv(move, ply);
+
+                if (alpha >= beta)
+                    break;
+            }
+        }
+    }
+
+    return best;
+}
+
+Value Search::static_eval(std::int32_t ply) {
+    const StackEntry& entry = stack[ply];
+
+    return shared.network ? shared.network->evaluate(entry.acc, entry.pos.stm())
+                          : evaluate(entry.pos, pawn_table);
+}
+
+// Copy-makes `move` into the next stack frame if it is legal, and reports whether it was.
+bool Search::play(const Move move, std::int32_t ply) {
+    StackEntry&    entry = stack[ply];
+    PositionState& child = stack[ply + 1].pos;
+
+    if (!entry.pos.is_legal(move))
+        return false;
+
+    entry.move         = move;
+    entry.moved        = entry.pos.piece_on(move.from());
+    entry.continuation = &continuation_history[entry.moved.to_underlying()][move.to().ordinal()];
+
+    child = stack[ply].pos;
+    child.make_move(move);
+
+    // The child's bucket is needed as soon as the child is searched; start loading it now.
+    tt.prefetch(child.key());
+
+    assert(child.is_ok());
+
+    if (shared.network)
+        shared.network->update(stack[ply].acc, stack[ply + 1].acc, child.dirty_pieces());
+
+    nodes++;
+    counter.nodes.store(nodes, std::memory_order_relaxed);
+    return true;
+}
+
+void Search::update_pv(const Move move, std::int32_t ply) {
+    StackEntry&       entry = stack[ply];
+    const StackEntry& child = stack[ply + 1];
+
+    entry.pv[0] = move;
+
+    for (std::int32_t i = 0; i < child.pv_length; i++)
+        entry.pv[i + 1] = child.pv[i];
+
+    entry.pv_length = child.pv_length + 1;
+}
+
+// Rewards the quiet move that caused a cutoff and penalizes the quiets searched before it.
+void Search::update_quiet_stats(std::int32_t     ply,
+                                std::int32_t     depth,
+                                const Move       move,
+                                const QuietList& quiets_tried) {
+    const std::int32_t bonus = std::min(16 * depth * depth, HISTORY_BONUS_MAX);
+
+    update_history(ply, move, bonus);
+
+    for (const Move quiet : quiets_tried)
+        update_history(ply, quiet, -bonus);
+
+    std::array<Move, 2>& killers = stack[ply].killers;
+
+    if (killers[0] != move)
+    {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+
+    if (ply > 0)
+    {
+        const StackEntry& previous = stack[ply - 1];
+        counter_moves[previous.moved.to_underlying()][previous.move.to().ordinal()] = move;
+    }
+}
+
+void Search::update_history(std::int32_t ply, const Move move, std::int32_t bonus) {
+    const PositionState& pos   = stack[ply].pos;
+    const std::size_t    piece = pos.piece_on(move.from()).to_underlying();
+    const std::size_t    to    = move.to().ordinal();
+
+    history[pos.stm().to_underlying()][move.from().ordinal() * Square::COUNT() + to].update(bonus);
+
+    for (std::int32_t back = 1; back <= 2 && back <= ply; back++)
+        (*stack[ply - back].continuation)[piece][to].update(bonus);
+}
+
+// Helpers stagger their iterations so that the threads are spread over neighbouring depths
+// instead of all searching the same tree in lockstep. The main thread searches every depth.
+bool Search::skip_depth(std::int32_t depth) const noexcept {
+    if (thread_id == 0)
+        return false;
+
+    const std::size_t i = (thread_id - 1) % SKIP_SIZE.size();
+    return ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2 != 0;
+}
+
+// Fifty moves without a capture or pawn move, or any earlier occurrence of the position since the
+// last such move, in the tree or in the game. A single repetition is enough: if repeating is good
+// for one side, it can repeat again.
+bool Search::is_draw(std::int32_t ply) const noexcept {
+    const PositionState& pos = stack[ply].pos;
+
+    // Checkmate on the move that reaches the limit still wins.
+    if (pos.halfmove_clock() >= 100)
+        return !pos.in_check() || count_legal_moves(pos) > 0;
+
+    const std::vector<std::uint64_t>& game = shared.history;
+
+    // Only positions with the same side to move and no irreversible move in between can repeat.
+    for (std::int32_t back = 4; back <= pos.halfmove_clock(); back += 2)
+    {
+        const std::int32_t i = ply - back;
+
+        if (i >= 0)
+        {
+            if (stack[i].pos.key() == pos.key())
+                return true;
+        }
+        else if (static_cast<std::size_t>(-i) > game.size())
+            break;
+        else if (game[game.size() + i] == pos.key())
+            return true;
+    }
+
+    return false;
+}
+
+// Only the main thread looks at the limits; helpers run until it finishes and raises `abort`.
+bool Search::should_stop() {
+    if (stopped)
+        return true;
+
+    if (shared.abort.load(std::memory_order_relaxed)
+        || shared.stop.load(std::memory_order_relaxed))
+        return stopped = true;
+
+    if (thread_id != 0)
+        return false;
+
+    const SearchLimits& limits = shared.limits;
+
+    if (limits.nodes > 0 && shared.threads == 1 && nodes >= limits.nodes)
+        return stopped = true;
+
+    if (--poll_countdown > 0)
+        return false;
+
+    poll_countdown = CHECK_INTERVAL;
+
+    if (limits.nodes > 0 && shared.total_nodes() >= limits.nodes)
+        return stopped = true;
+
+    if (shared.time.hard_limit_reached())
+        return stopped = true;
+
+    return false;
+}
+
+void Search::report(std::int32_t depth, Value score) const {
+    if (!shared.verbose)
+        return;
+
+    const std::uint64_t total = shared.total_nodes();
+    const std::int64_t  time  = shared.time.elapsed_ms();
+    const std::uint64_t nps   = time > 0 ? total * 1000 / time : 0;
+
+    std::string line = "info depth " + std::to_string(depth) + " score ";
+
+    if (score >= VALUE_MATE_IN_MAX_PLY)
+        line += "mate " + std::to_string((VALUE_MATE - score + 1) / 2);
+    else if (score <= -VALUE_MATE_IN_MAX_PLY)
+        line += "mate " + std::to_string(-(VALUE_MATE + score) / 2);
+    else
+        line += "cp " + std::to_string(score);
+
+    line += " nodes " + std::to_string(total) + " nps " + std::to_string(nps) + " hashfull "
+          + std::to_string(tt.hashfull()) + " time " + std::to_string(time) + " pv";
+
+    for (std::int32_t i = 0; i < stack[0].pv_length; i++)
+        line += " " + stack[0].pv[i].to_uci();
+
+    send(line);
+}
+
+SearchResult search(const PositionState&                      pos,
+                    const std::vector<std::uint64_t>&         history,
+                    const SearchLimits&                       limits,
+                    const std::atomic<bool>&                  stop,
+                    TranspositionTable&                       tt,
+                    const Network*                            network,
+                    Utility::ThreadPool*                      helpers,
+                    std::vector<std::unique_ptr<ThreadData>>& thread_data,
+                    bool                                      verbose) {
+    tt.new_search();
+
+    const std::size_t threads = 1 + (helpers ? helpers->size() : 0);
+    SharedSearchState shared{pos, history, limits, stop, tt, network, threads, verbose};
+
+    std::vector<std::unique_ptr<Search>> searches;
+
+    while (thread_data.size() < threads)
+        thread_data.push_back(std::make_unique<ThreadData>());
+
+    for (std::size_t i = 0; i < threads; i++)
+        searches.push_back(std::make_unique<Search>(pos, shared, *thread_data[i], i));
+
+    for (std::size_t i = 1; i < threads; i++)
+        helpers->submit([&searches, i](std::size_t) { searches[i]->run(); });
+
+    searches[0]->run();
+    shared.abort.store(true, std::memory_order_relaxed);
+
+    if (helpers)
+        helpers->wait();
+
+    return {vote(searches), shared.total_nodes(), searches[0]->completed_depth()};
+}
+
+}
@@ -0,0 +1,186 @@
+#ifndef VOLTA_SEARCH_HPP__
+#define VOLTA_SEARCH_HPP__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common.hpp"
+#include "evaluate.hpp"
+#include "move.hpp"
+#include "movegen.hpp"
+#include "movepick.hpp"
+#include "nnue.hpp"
+#include "position.hpp"
+#include "threadpool.hpp"
+#include "timeman.hpp"
+#include "tt.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+inline constexpr std::int32_t MAX_PLY = 128;
+
+inline constexpr Value VALUE_DRAW            = 0;
+inline constexpr Value VALUE_MATE            = 32000;
+inline constexpr Value VALUE_INFINITE        = 32001;
+inline constexpr Value VALUE_NONE            = 32002;
+inline constexpr Value VALUE_MATE_IN_MAX_PLY = VALUE_MATE - MAX_PLY;
+
+// Per-thread node count on its own cache line, so that counting never causes false sharing. The
+// counts are only summed when reporting or checking a node limit.
+struct alignas(64) NodeCounter {
+    std::atomic<std::uint64_t> nodes{0};
+};
+
+// Everything the threads of one `go` share besides the transposition table. Thread 0 is the main
+// thread: it alone enforces the limits and reports, and raises `abort` once it has finished.
+struct SharedSearchState {
+    SharedSearchState(const PositionState&              root,
+                      const std::vector<std::uint64_t>& history,
+                      const SearchLimits&               limits,
+                      const std::atomic<bool>&          stop,
+                      TranspositionTable&               tt,
+                      const Network*                    network,
+                      std::size_t                       threads,
+                      bool                              verbose);
+
+    std::uint64_t total_nodes() const noexcept;
+
+    // Keys of the game positions before the root, oldest first, for repetition detection.
+    const std::vector<std::uint64_t>& history;
+
+    const SearchLimits&      limits;
+    const std::atomic<bool>& stop;
+    TranspositionTable&      tt;
+    const Network*           network;
+    std::atomic<bool>        abort;
+
+    std::size_t                    threads;
+    std::unique_ptr<NodeCounter[]> counters;
+    bool                           verbose;
+    TimeManager                    time;
+};
+
+// Per-thread state that outlives a single `go`: the move-ordering histories and the pawn hash. The
+// caller keeps one per search thread, so every search starts from what the previous ones learned
+// instead of from cold, freshly zeroed tables. Large; create it on the heap.
+struct ThreadData {
+    ThreadData();
+
+    // Forgets the histories for a new game. Pawn entries depend on the pawns alone and are kept.
+    void clear();
+
+    ButterflyHistory    history;
+    ContinuationHistory continuation_history;
+    CounterMoves        counter_moves;
+    PawnTable           pawn_table;
+};
+
+// Iterative deepening over a principal-variation negamax with a capture-only quiescence search.
+// Every ply plays into its own preallocated stack frame (copy-make), so nothing is allocated
+// inside the tree. The object is large; create it on the heap.
+class Search {
+   public:
+    Search(const PositionState& root,
+           SharedSearchState&   shared,
+           ThreadData&          data,
+           std::size_t          thread_id);
+
+    // Searches until a limit is hit or the main thread finishes. The main thread prints one `info`
+    // line per completed depth.
+    void run();
+
+    Move         best_move() const noexcept { return best_move_; }
+    Value        best_score() const noexcept { return best_score_; }
+    std::int32_t completed_depth() const noexcept { return completed_depth_; }
+
+   private:
+    struct StackEntry {
+        PositionState             pos;
+        std::array<Move, MAX_PLY> pv;
+        std::int32_t              pv_length;
+        Accumulator               acc;
+
+        // The move searched from this frame and its piece, and that pair's continuation table.
+        Move            move;
+        Piece           moved;
+        PieceToHistory* continuation;
+
+        std::array<Move, 2> killers;
+    };
+
+    using QuietList = Utility::fixed_vector<Move, 64>;
+
+    Value negamax(std::int32_t depth, std::int32_t ply, Value alpha, Value beta);
+    Value qsearch(std::int32_t ply, Value alpha, Value beta);
+
+    Value static_eval(std::int32_t ply);
+    bool  play(const Move move, std::int32_t ply);
+    void  update_pv(const Move move, std::int32_t ply);
+    void  update_quiet_stats(std::int32_t     ply,
+                             std::int32_t     depth,
+                             const Move       move,
+                             const QuietList& quiets_tried);
+    void  update_history(std::int32_t ply, const Move move, std::int32_t bonus);
+    bool  skip_depth(std::int32_t depth) const noexcept;
+    bool  is_draw(std::int32_t ply) const noexcept;
+    bool  should_stop();
+    void  report(std::int32_t depth, Value score) const;
+
+    SharedSearchState&  shared;
+    TranspositionTable& tt;
+    const std::size_t   thread_id;
+    NodeCounter&        counter;
+
+    std::uint64_t nodes;
+    std::uint64_t poll_countdown;
+    bool          stopped;
+
+    Move         best_move_;
+    Value        best_score_;
+    std::int32_t completed_depth_;
+
+    // The last completed iteration's PV, tried first at each ply of the next one.
+    std::array<Move, MAX_PLY> previous_pv;
+    std::int32_t              previous_pv_length;
+
+    // Owned by this thread's ThreadData.
+    ButterflyHistory&    history;
+    ContinuationHistory& continuation_history;
+    CounterMoves&        counter_moves;
+    PawnTable&           pawn_table;
+
+    std::array<StackEntry, MAX_PLY + 1> stack;
+};
+
+struct SearchResult {
+    Move          best_move;
+    std::uint64_t nodes;
+    std::int32_t  depth;
+};
+
+// Searches `pos` with the calling thread plus one helper per worker of `helpers` (lazy SMP), until
+// the limits are reached or `stop` is raised. `history` holds the keys of the positions played
+// before `pos`, oldest first, so that repeating them scores as a draw. Leaves are scored by
+// `network` if one is given and by the hand-written evaluation otherwise. The best move is voted on
+// by all threads, and is Move::NONE() if the side to move has no legal move. Thread i searches with
+// `thread_data[i]`; missing entries are created, and all of them are kept for the next search.
+SearchResult search(const PositionState&                      pos,
+                    const std::vector<std::uint64_t>&         history,
+                    const SearchLimits&                       limits,
+                    const std::atomic<bool>&                  stop,
+                    TranspositionTable&                       tt,
+                    const Network*                            network,
+                    Utility::ThreadPool*                      helpers,
+                    std::vector<std::unique_ptr<ThreadData>>& thread_data,
+                    bool                                      verbose = true);
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include "threadpool.hpp"
+
+#include <cassert>
+
+namespace Volta::Utility {
+
+namespace {
+
+thread_local const ThreadPool* current_pool   = nullptr;
+thread_local std::size_t       current_worker = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t thread_count) :
+    queued{0},
+    pending{0},
+    next_queue{0},
+    stopping{false} {
+    assert(thread_count > 0);
+
+    for (std::size_t i = 0; i < thread_count; i++)
+        queues.push_back(std::make_unique<WorkQueue>());
+
+    for (std::size_t i = 0; i < thread_count; i++)
+        workers.emplace_back(&ThreadPool::worker_loop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{idle_mutex};
+        stopping = true;
+    }
+
+    idle_cv.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::submit(Task task) {
+    const std::size_t target = current_pool == this
+                               ? current_worker
+                               : next_queue.fetch_add(1, std::memory_order_relaxed) % size();
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+
+    // Count the task before publishing it so that a thief can never decrement past zero.
+    {
+        std::lock_guard lock{idle_mutex};
+        queued.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard lock{queues[target]->mutex};
+        queues[target]->tasks.push_back(std::move(task));
+    }
+
+    idle_cv.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock{idle_mutex};
+    done_cv.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+bool ThreadPool::try_pop(std::size_t worker, Task& task) {
+    WorkQueue&      queue = *queues[worker];
+    std::lock_guard lock{queue.mutex};
+
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::try_steal(std::size_t thief, Task& task) {
+    for (std::size_t i = 1; i < size(); i++)
+    {
+        WorkQueue&      victim = *queues[(thief + i) % size()];
+        std::lock_guard lock{victim.mutex};
+
+        if (victim.tasks.empty())
+            continue;
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::worker_loop(std::size_t worker) {
+    current_pool   = this;
+    current_worker = worker;
+
+    for (;;)
+    {
+        Task task;
+
+        if (try_pop(worker, task) || try_steal(worker, task))
+        {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task(worker);
+
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard lock{idle_mutex};
+                done_cv.notify_all();
+            }
+
+            continue;
+        }
+
+        std::unique_lock lock{idle_mutex};
+        idle_cv.wait(lock, [this] {
+            return stopping || queued.load(std::memory_order_acquire) > 0;
+        });
+
+        if (stopping && queued.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+}
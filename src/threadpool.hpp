@@ -0,0 +1,61 @@
+#ifndef VOLTA_THREADPOOL_HPP__
+#define VOLTA_THREADPOOL_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Volta::Utility {
+
+// Work-stealing thread pool. Every worker owns a deque: tasks submitted from a worker go to the
+// back of its own deque and are popped LIFO, while idle workers steal FIFO from the front of
+// other deques, so large (shallow) subtrees are the ones that migrate between threads.
+class ThreadPool {
+   public:
+    using Task = std::function<void(std::size_t worker)>;
+
+    explicit ThreadPool(std::size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+    void wait();
+
+    // The queues are all created before the first worker starts and never change afterwards, so
+    // workers may read their count while the constructor is still launching threads.
+    std::size_t size() const noexcept { return queues.size(); }
+
+   private:
+    struct alignas(64) WorkQueue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool try_pop(std::size_t worker, Task& task);
+    bool try_steal(std::size_t thief, Task& task);
+    void worker_loop(std::size_t worker);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread>                workers;
+
+    std::mutex              idle_mutex;
+    std::condition_variable idle_cv;
+    std::condition_variable done_cv;
+
+    std::atomic<std::size_t> queued;
+    std::atomic<std::size_t> pending;
+    std::atomic<std::size_t> next_queue;
+    bool                     stopping;
+};
+
+}
+
+#endif
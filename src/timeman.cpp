@@ -0,0 +1,64 @@
+#include "timeman.hpp"
+
+#include <algorithm>
+
+namespace Volta::Engine {
+
+namespace {
+
+// Kept back from every move for communication and process scheduling.
+constexpr std::int64_t MOVE_OVERHEAD = 10;
+
+// Horizon assumed under sudden death, and the longest one honoured from `movestogo`.
+constexpr std::int32_t DEFAULT_MOVES_TO_GO = 30;
+constexpr std::int32_t MAX_MOVES_TO_GO     = 50;
+
+// Soft limit scale, in percent, by the number of iterations the best move has been stable for.
+constexpr std::array<std::int64_t, 5> STABILITY_SCALE = {250, 160, 120, 100, 80};
+
+}  // namespace
+
+TimeManager::TimeManager(const SearchLimits& limits, const Color stm) :
+    start{Clock::now()},
+    soft{0},
+    hard{0},
+    fixed{false} {
+    const std::int64_t time      = limits.time[stm.to_underlying()];
+    const std::int64_t increment = limits.increment[stm.to_underlying()];
+
+    if (limits.move_time > 0)
+    {
+        soft  = std::max<std::int64_t>(1, limits.move_time - MOVE_OVERHEAD);
+        hard  = soft;
+        fixed = true;
+    }
+    else if (time > 0)
+    {
+        const std::int64_t available  = std::max<std::int64_t>(1, time - MOVE_OVERHEAD);
+        const std::int32_t moves_left = limits.moves_to_go > 0
+                                        ? std::min(limits.moves_to_go, MAX_MOVES_TO_GO)
+                                        : DEFAULT_MOVES_TO_GO;
+        const std::int64_t base       = available / moves_left + increment * 3 / 4;
+
+        hard = std::max<std::int64_t>(1, std::min(base * 3, available * 3 / 4));
+        soft = std::max<std::int64_t>(1, std::min(base * 6 / 10, hard));
+    }
+}
+
+std::int64_t TimeManager::elapsed_ms() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+bool TimeManager::soft_limit_reached(std::int32_t stability) const {
+    if (!enabled())
+        return false;
+
+    const std::size_t  index = std::min<std::size_t>(stability, STABILITY_SCALE.size() - 1);
+    const std::int64_t limit = fixed ? soft : std::min(hard, soft * STABILITY_SCALE[index] / 100);
+
+    return elapsed_ms() >= limit;
+}
+
+bool TimeManager::hard_limit_reached() const { return enabled() && elapsed_ms() >= hard; }
+
+}
@@ -0,0 +1,54 @@
+#ifndef VOLTA_TIMEMAN_HPP__
+#define VOLTA_TIMEMAN_HPP__
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "common.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+// Constraints from a UCI `go` command. Times are in milliseconds; zero means "not given".
+struct SearchLimits {
+    std::array<std::int64_t, Color::COUNT()> time{};
+    std::array<std::int64_t, Color::COUNT()> increment{};
+    std::int32_t                             moves_to_go = 0;
+    std::int32_t                             depth       = 0;
+    std::uint64_t                            nodes       = 0;
+    std::int64_t                             move_time   = 0;
+    bool                                     infinite    = false;
+};
+
+// Turns the clock into two limits. The soft limit is checked between iterations, and scaled up
+// while the best move keeps changing; the hard limit aborts the search mid-iteration. A fixed
+// `movetime` makes both limits equal and unscaled.
+class TimeManager {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    TimeManager(const SearchLimits& limits, const Color stm);
+
+    bool enabled() const noexcept { return hard > 0; }
+
+    std::int64_t elapsed_ms() const;
+
+    // `stability` is the number of consecutive iterations that have kept the same best move.
+    bool soft_limit_reached(std::int32_t stability) const;
+    bool hard_limit_reached() const;
+
+    std::int64_t soft_limit() const noexcept { return soft; }
+    std::int64_t hard_limit() const noexcept { return hard; }
+
+   private:
+    Clock::time_point start;
+    std::int64_t      soft;
+    std::int64_t      hard;
+    bool              fixed;
+};
+
+}
+
+#endif
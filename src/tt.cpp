@@ -0,0 +1,148 @@
+#include "tt.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace Volta::Engine {
+
+namespace {
+
+constexpr std::uint8_t AGE_CYCLE = 1 << 6;
+
+// The bucket index comes from the high bits of the key, so the fragment takes the low bits, which
+// the index does not depend on.
+std::uint16_t key_fragment(std::uint64_t key) { return static_cast<std::uint16_t>(key); }
+
+}  // namespace
+
+std::uint16_t TranspositionTable::Entry::payload_hash() const noexcept {
+    std::uint16_t move_bits;
+    std::memcpy(&move_bits, &move, sizeof(move_bits));
+
+    return move_bits ^ static_cast<std::uint16_t>(value) ^ static_cast<std::uint16_t>(eval)
+         ^ static_cast<std::uint16_t>(depth | (age_bound << 8));
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) :
+    bucket_count{0},
+    age{0} {
+    resize(megabytes, 1);
+}
+
+void TranspositionTable::resize(std::size_t megabytes, std::size_t threads) {
+    bucket_count = std::max<std::size_t>(megabytes, 1) * 1024 * 1024 / sizeof(Bucket);
+    buckets      = std::make_unique_for_overwrite<Bucket[]>(bucket_count);
+
+    clear(threads);
+}
+
+// Every thread zeroes one contiguous slice, which also spreads first-touch page faults.
+void TranspositionTable::clear(std::size_t threads) {
+    threads = std::clamp<std::size_t>(threads, 1, bucket_count);
+
+    std::vector<std::thread> workers;
+
+    for (std::size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back([this, i, threads] {
+            const std::size_t first = bucket_count * i / threads;
+            const std::size_t last  = bucket_count * (i + 1) / threads;
+
+            std::memset(static_cast<void*>(&buckets[first]), 0, (last - first) * sizeof(Bucket));
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    age = 0;
+}
+
+void TranspositionTable::new_search() noexcept { age = (age + 1) % AGE_CYCLE; }
+
+bool TranspositionTable::probe(std::uint64_t key, TTData& data) const noexcept {
+    const Bucket&       bucket   = buckets[index(key)];
+    const std::uint16_t fragment = key_fragment(key);
+
+    for (const Entry& stored : bucket.entries)
+    {
+        const Entry entry = stored;
+
+        if (entry.bound() == Bound::NONE || (entry.key16 ^ entry.payload_hash()) != fragment)
+            continue;
+
+        data = {.move  = entry.move,
+                .value = entry.value,
+                .eval  = entry.eval,
+                .depth = entry.depth,
+                .bound = entry.bound()};
+        return true;
+    }
+
+    return false;
+}
+
+// Overwrites the entry for the same position if there is one, otherwise the entry that is worth
+// least: shallow and written by an older search.
+void TranspositionTable::store(std::uint64_t key,
+                               Move          move,
+                               Value         value,
+                               Value         eval,
+                               std::int32_t  depth,
+                               Bound         bound) noexcept {
+    Bucket&             bucket   = buckets[index(key)];
+    const std::uint16_t fragment = key_fragment(key);
+
+    Entry* replace      = &bucket.entries[0];
+    int    replace_rank = std::numeric_limits<int>::max();
+    bool   same_key     = false;
+
+    for (Entry& entry : bucket.entries)
+    {
+        if (entry.bound() == Bound::NONE || (entry.key16 ^ entry.payload_hash()) == fragment)
+        {
+            replace  = &entry;
+            same_key = entry.bound() != Bound::NONE;
+            break;
+        }
+
+        const int relative_age = (AGE_CYCLE + age - entry.age()) % AGE_CYCLE;
+        const int rank         = entry.depth - 8 * relative_age;
+
+        if (rank < replace_rank)
+        {
+            replace      = &entry;
+            replace_rank = rank;
+        }
+    }
+
+    // A fail-low result has no best move; keep the one found earlier for this position.
+    if (same_key && move == Move::NONE())
+        move = replace->move;
+
+    Entry entry;
+    entry.move      = move;
+    entry.value     = static_cast<std::int16_t>(value);
+    entry.eval      = static_cast<std::int16_t>(eval);
+    entry.depth     = static_cast<std::uint8_t>(std::clamp(depth, 0, 255));
+    entry.age_bound = static_cast<std::uint8_t>((age << 2) | static_cast<std::uint8_t>(bound));
+    entry.key16     = fragment ^ entry.payload_hash();
+
+    *replace = entry;
+}
+
+std::int32_t TranspositionTable::hashfull() const noexcept {
+    const std::size_t samples = std::min<std::size_t>(bucket_count, 1000);
+    std::int32_t      used    = 0;
+
+    for (std::size_t i = 0; i < samples; i++)
+        for (const Entry& entry : buckets[i].entries)
+            used += entry.bound() != Bound::NONE && entry.age() == age;
+
+    return static_cast<std::int32_t>(used * 1000 / (samples * ENTRIES_PER_BUCKET));
+}
+
+}
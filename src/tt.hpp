@@ -0,0 +1,95 @@
+#ifndef VOLTA_TT_HPP__
+#define VOLTA_TT_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "evaluate.hpp"
+#include "move.hpp"
+
+namespace Volta::Engine {
+
+using namespace Chess;
+
+enum class Bound : std::uint8_t {
+    NONE,
+    UPPER,
+    LOWER,
+    EXACT
+};
+
+struct TTData {
+    Move         move;
+    Value        value;
+    Value        eval;
+    std::int32_t depth;
+    Bound        bound;
+};
+
+// Transposition table shared by all search threads without locks. A 32-byte bucket holds three
+// 10-byte entries. Entries are written field by field, so a concurrent writer can leave one torn;
+// the stored key fragment is XORed with a fold of the entry's payload, which makes a torn entry
+// fail verification instead of being trusted. Moves read from the table must still be checked
+// against the position before they are played.
+class TranspositionTable {
+   public:
+    explicit TranspositionTable(std::size_t megabytes);
+
+    // Reallocates to `megabytes` and clears with `threads` threads. Not safe during a search.
+    void resize(std::size_t megabytes, std::size_t threads);
+    void clear(std::size_t threads);
+
+    // Advances the age stamped on new entries; call once per `go`.
+    void new_search() noexcept;
+
+    bool probe(std::uint64_t key, TTData& data) const noexcept;
+    void store(std::uint64_t key,
+               Move          move,
+               Value         value,
+               Value         eval,
+               std::int32_t  depth,
+               Bound         bound) noexcept;
+
+    void prefetch(std::uint64_t key) const noexcept { __builtin_prefetch(&buckets[index(key)]); }
+
+    // Permille of sampled entries written during the current search, for UCI `hashfull`.
+    std::int32_t hashfull() const noexcept;
+
+   private:
+    struct Entry {
+        std::uint16_t key16;
+        Move          move;
+        std::int16_t  value;
+        std::int16_t  eval;
+        std::uint8_t  depth;
+        std::uint8_t  age_bound;
+
+        std::uint16_t payload_hash() const noexcept;
+        Bound         bound() const noexcept { return static_cast<Bound>(age_bound & 0b11); }
+        std::uint8_t  age() const noexcept { return age_bound >> 2; }
+    };
+
+    static constexpr std::size_t ENTRIES_PER_BUCKET = 3;
+
+    struct alignas(32) Bucket {
+        std::array<Entry, ENTRIES_PER_BUCKET> entries;
+        std::array<char, 2>                   padding;
+    };
+
+    static_assert(sizeof(Entry) == 10);
+    static_assert(sizeof(Bucket) == 32);
+
+    std::size_t index(std::uint64_t key) const noexcept {
+        return static_cast<std::size_t>((static_cast<unsigned __int128>(key) * bucket_count) >> 64);
+    }
+
+    std::unique_ptr<Bucket[]> buckets;
+    std::size_t               bucket_count;
+    std::uint8_t              age;
+};
+
+}
+
+#endif
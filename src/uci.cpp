@@ -1,24 +1,485 @@
 #include "uci.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+
 #include "movegen.hpp"
+#include "perft.hpp"
+#include "search.hpp"
 
 namespace Volta {
 
 namespace Engine {
 
+namespace {
+
+constexpr std::size_t DEFAULT_HASH_MB = 16;
+constexpr std::size_t MAX_HASH_MB     = 1 << 20;
+constexpr std::size_t MAX_THREADS     = 1024;
+
+std::mutex output_mutex;
+
+std::size_t clear_threads() { return std::max(1U, std::thread::hardware_concurrency()); }
+
+std::vector<std::string_view> tokenize(std::string_view line) {
+    std::vector<std::string_view> tokens;
+
+    for (const std::string_view token : Utility::split(line, ' '))
+        if (!token.empty())
+            tokens.push_back(token);
+
+    return tokens;
+}
+
+// Checks everything from_fen relies on: six fields, a board of eight full ranks with one king per
+// side, a side to move, castling rights and an en passant square.
+bool is_valid_fen(std::string_view fen) {
+    const std::vector<std::string_view> fields = Utility::split(fen, ' ');
+
+    if (fields.size() != 6)
+        return false;
+
+    const std::vector<std::string_view> ranks = Utility::split(fields[0], '/');
+
+    if (ranks.size() != 8)
+        return false;
+
+    std::size_t white_kings = 0;
+    std::size_t black_kings = 0;
+
+    for (const std::string_view rank : ranks)
+    {
+        std::size_t files = 0;
+
+        for (const char ch : rank)
+        {
+            if (ch >= '1' && ch <= '8')
+                files += ch - '0';
+            else if (std::string_view("PNBRQKpnbrqk").find(ch) != std::string_view::npos)
+                files++;
+            else
+                return false;
+
+            white_kings += ch == 'K';
+            black_kings += ch == 'k';
+        }
+
+        if (files != 8)
+            return false;
+    }
+
+    if (white_kings != 1 || black_kings != 1)
+        return false;
+
+    if (fields[1] != "w" && fields[1] != "b")
+        return false;
+
+    if (fields[2] != "-"
+        && (fields[2].empty() || fields[2].find_first_not_of("KQkq") != std::string_view::npos))
+        return false;
+
+    if (fields[3] != "-"
+        && (fields[3].size() != 2 || fields[3][0] < 'a' || fields[3][0] > 'h'
+            || (fields[3][1] != '3' && fields[3][1] != '6')))
+        return false;
+
+    return true;
+}
+
+// The whole of `token` as an integer. Anything else is reported to the GUI and yields nothing, so
+// that the caller keeps its previous value.
+std::optional<std::int64_t> parse_int(std::string_view token) {
+    std::int64_t value = 0;
+    const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+
+    if (error != std::errc{} || end != token.data() + token.size())
+    {
+        send("info string invalid number " + std::string(token));
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+}  // namespace
+
+void send(const std::string& line) {
+    std::lock_guard lock{output_mutex};
+    std::cout << line << std::endl;
+}
+
+// Decodes the squares and promotion piece directly, derives the flag from the position, and then
+// checks that the result is a move the generator would have produced.
 Move move_from_uci(const PositionState& pos, std::string_view token) {
-    MoveList moves;
-    append_all_moves(moves, pos);
+    if (token.size() != 4 && token.size() != 5)
+        return Move::NONE();
 
-    for (const Move move : moves)
+    const auto is_square = [](const char file, const char rank) {
+        return file >= 'a' && file <= 'h' && rank >= '1' && rank <= '8';
+    };
+
+    if (!is_square(token[0], token[1]) || !is_square(token[2], token[3]))
+        return Move::NONE();
+
+    const Square from  = Square(File::from_char(token[0]), Rank::from_char(token[1]));
+    const Square to    = Square(File::from_char(token[2]), Rank::from_char(token[3]));
+    const Piece  piece = pos.piece_on(from);
+
+    if (!piece.is_valid())
+        return Move::NONE();
+
+    MoveFlag flag = pos.piece_on(to).is_valid() ? MoveFlag::CAPTURE() : MoveFlag::NORMAL();
+
+    if (piece.type() == PieceType::KING() && distance(from.file(), to.file()) == 2)
+        flag = MoveFlag::CASTLING();
+    else if (piece.type() == PieceType::PAWN() && to == pos.en_passant_destination()
+             && from.file().to_underlying() != to.file().to_underlying())
+        flag = MoveFlag::EN_PASSANT();
+
+    if (token.size() == 5)
+    {
+        const PieceType promotion = Piece::from_char(token[4]).type();
+
+        if (promotion == PieceType::PAWN() || promotion == PieceType::KING()
+            || promotion == PieceType::NONE())
+            return Move::NONE();
+
+        flag = MoveFlag::make_promotion(promotion) | flag;
+    }
+
+    const Move move(flag, from, to);
+    return pos.is_pseudo_legal(move) ? move : Move::NONE();
+}
+
+Uci::Uci() :
+    pos{PositionState::startpos()},
+    tt{DEFAULT_HASH_MB},
+    own_book{false},
+    book_rng{static_cast<std::uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count())},
+    stop{false},
+    search_thread{1},
+    reader{&Uci::read_input, this} {
+    network.load_embedded();
+}
+
+Uci::~Uci() {
+    stop_search();
+    reader.join();
+}
+
+void Uci::loop() {
+    std::string line;
+
+    while (next_command(line))
     {
-        if (move.to_uci() == token)
+        if (!execute(tokenize(line)))
+            break;
+    }
+}
+
+void Uci::read_input() {
+    std::string line;
+    bool        quit = false;
+
+    while (!quit && std::getline(std::cin, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        const Tokens tokens = tokenize(line);
+        quit                = !tokens.empty() && tokens[0] == "quit";
+
+        if (quit || (!tokens.empty() && tokens[0] == "stop"))
+            stop.store(true, std::memory_order_relaxed);
+
+        std::lock_guard lock{input_mutex};
+        input.push_back(line);
+        input_cv.notify_one();
+    }
+
+    // End of input behaves like `quit`.
+    if (!quit)
+    {
+        stop.store(true, std::memory_order_relaxed);
+
+        std::lock_guard lock{input_mutex};
+        input.push_back("quit");
+        input_cv.notify_one();
+    }
+}
+
+bool Uci::next_command(std::string& line) {
+    std::unique_lock lock{input_mutex};
+    input_cv.wait(lock, [this] { return !input.empty(); });
+
+    line = std::move(input.front());
+    input.pop_front();
+    return true;
+}
+
+bool Uci::execute(const Tokens& tokens) {
+    if (tokens.empty())
+        return true;
+
+    const std::string_view command = tokens[0];
+
+    if (command == "uci")
+        uci();
+    else if (command == "isready")
+        send("readyok");
+    else if (command == "setoption")
+        set_option(tokens);
+    else if (command == "ucinewgame")
+        new_game();
+    else if (command == "position")
+        position(tokens);
+    else if (command == "go")
+        go(tokens);
+    else if (command == "stop")
+        stop_search();
+    else if (command == "quit")
+        return false;
+    else if (command == "d")
+    {
+        std::ostringstream board;
+        board << pos;
+        send(board.str());
+    }
+    else
+        send("info string unknown command " + std::string(command));
+
+    return true;
+}
+
+void Uci::uci() const {
+    send("id name Volta");
+    send("id author Shawn Xu");
+    send("option name Hash type spin default " + std::to_string(DEFAULT_HASH_MB) + " min 1 max "
+         + std::to_string(MAX_HASH_MB));
+    send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+    send("option name EvalFile type string default <empty>");
+    send("option name OwnBook type check default false");
+    send("option name BookFile type string default <empty>");
+    send("uciok");
+}
+
+// setoption name <id> [value <x>]
+void Uci::set_option(const Tokens& tokens) {
+    std::string name;
+    std::string value;
+    std::string* field = nullptr;
+
+    for (std::size_t i = 1; i < tokens.size(); i++)
+    {
+        if (tokens[i] == "name")
+            field = &name;
+        else if (tokens[i] == "value")
+            field = &value;
+        else if (field)
+            *field += (field->empty() ? "" : " ") + std::string(tokens[i]);
+    }
+
+    if (name == "Hash" && !value.empty())
+    {
+        const std::optional<std::int64_t> megabytes = parse_int(value);
+
+        if (!megabytes)
+            return;
+
+        stop_search();
+        tt.resize(static_cast<std::size_t>(std::clamp<std::int64_t>(*megabytes, 1, MAX_HASH_MB)),
+                  clear_threads());
+    }
+    else if (name == "Threads" && !value.empty())
+    {
+        const std::optional<std::int64_t> count = parse_int(value);
+
+        if (!count)
+            return;
+
+        stop_search();
+
+        const auto threads =
+          static_cast<std::size_t>(std::clamp<std::int64_t>(*count, 1, MAX_THREADS));
+        helpers.reset();
+        thread_data.resize(std::min(thread_data.size(), threads));
+
+        if (threads > 1)
+            helpers = std::make_unique<Utility::ThreadPool>(threads - 1);
+    }
+    else if (name == "EvalFile")
+    {
+        stop_search();
+
+        // Without a file, fall back to the embedded network, if any, then to the hand-written
+        // evaluation.
+        if (value.empty() || value == "<empty>")
+            network.load_embedded();
+        else if (network.load_file(value))
+            send("info string loaded " + value + " with " + Network::kernel_name() + " kernels");
+        else
+            send("info string failed to load " + value + ", using the classical evaluation");
+    }
+    else if (name == "OwnBook")
+        own_book = value == "true";
+    else if (name == "BookFile")
+    {
+        stop_search();
+
+        if (value.empty() || value == "<empty>")
+            book.close();
+        else if (book.open(value))
+            send("info string loaded " + value + " with " + std::to_string(book.size())
+                 + " entries");
+        else
+            send("info string failed to load " + value);
+    }
+    else
+        send("info string unknown option " + name);
+}
+
+void Uci::new_game() {
+    stop_search();
+    pos = PositionState::startpos();
+    history.clear();
+    tt.clear(clear_threads());
+
+    for (const auto& data : thread_data)
+        data->clear();
+}
+
+// position (startpos | fen <fen>) [moves <move>...]
+void Uci::position(const Tokens& tokens) {
+    std::size_t i = 1;
+
+    if (i < tokens.size() && tokens[i] == "startpos")
+    {
+        pos = PositionState::startpos();
+        i++;
+    }
+    else if (i < tokens.size() && tokens[i] == "fen")
+    {
+        std::string fen;
+        std::size_t fields = 0;
+
+        for (i++; i < tokens.size() && tokens[i] != "moves"; i++, fields++)
+            fen += (fen.empty() ? "" : " ") + std::string(tokens[i]);
+
+        // The halfmove and fullmove counters are optional in practice.
+        if (fields == 4)
+            fen += " 0 1";
+
+        // GUI input must never reach from_fen unchecked; keep the previous position instead.
+        if (!is_valid_fen(fen))
+        {
+            send("info string invalid fen");
+            return;
+        }
+
+        pos = PositionState::from_fen(fen);
+    }
+    else
+    {
+        send("info string invalid position command");
+        return;
+    }
+
+    history.clear();
+
+    if (i < tokens.size() && tokens[i] == "moves")
+    {
+        for (i++; i < tokens.size(); i++)
+        {
+            const Move move = move_from_uci(pos, tokens[i]);
+
+            if (move == Move::NONE() || !pos.is_legal(move))
+            {
+                send("info string illegal move " + std::string(tokens[i]));
+                return;
+            }
+
+            history.push_back(pos.key());
+            pos.make_move(move);
+        }
+    }
+}
+
+// go [wtime <x>] [btime <x>] [winc <x>] [binc <x>] [movestogo <x>] [depth <x>] [nodes <x>]
+//    [movetime <x>] [infinite] | go perft <depth>
+void Uci::go(const Tokens& tokens) {
+    stop_search();
+
+    SearchLimits limits;
+
+    // A value that does not parse leaves its limit unset.
+    for (std::size_t i = 1; i < tokens.size(); i++)
+    {
+        const std::string_view token = tokens[i];
+        const bool             has_value = i + 1 < tokens.size();
+
+        if (token == "infinite")
+            limits.infinite = true;
+        else if (!has_value)
+            break;
+        else if (token == "perft")
+        {
+            const std::optional<std::int64_t> depth = parse_int(tokens[++i]);
+
+            if (depth && *depth > 0)
+                split_perft(pos, static_cast<std::int32_t>(*depth));
+
+            return;
+        }
+        else if (token == "wtime")
+            limits.time[Color::WHITE().to_underlying()] = parse_int(tokens[++i]).value_or(0);
+        else if (token == "btime")
+            limits.time[Color::BLACK().to_underlying()] = parse_int(tokens[++i]).value_or(0);
+        else if (token == "winc")
+            limits.increment[Color::WHITE().to_underlying()] = parse_int(tokens[++i]).value_or(0);
+        else if (token == "binc")
+            limits.increment[Color::BLACK().to_underlying()] = parse_int(tokens[++i]).value_or(0);
+        else if (token == "movestogo")
+            limits.moves_to_go = static_cast<std::int32_t>(parse_int(tokens[++i]).value_or(0));
+        else if (token == "depth")
+            limits.depth = static_cast<std::int32_t>(parse_int(tokens[++i]).value_or(0));
+        else if (token == "nodes")
+            limits.nodes = static_cast<std::uint64_t>(parse_int(tokens[++i]).value_or(0));
+        else if (token == "movetime")
+            limits.move_time = parse_int(tokens[++i]).value_or(0);
+    }
+
+    // An infinite search has to wait for `stop`, so it is never cut short by the book.
+    if (own_book && !limits.infinite)
+    {
+        const Move book_move = book.probe(pos, book_rng);
+
+        if (book_move != Move::NONE())
         {
-            return move;
+            send("bestmove " + book_move.to_uci());
+            return;
         }
     }
 
-    return Move::NONE();
+    stop.store(false, std::memory_order_relaxed);
+
+    search_thread.submit([this, root = pos, history = history, limits](std::size_t) {
+        const Move best = search(root, history, limits, stop, tt,
+                                 network.loaded() ? &network : nullptr, helpers.get(),
+                                 thread_data)
+                            .best_move;
+        send("bestmove " + (best == Move::NONE() ? std::string("0000") : best.to_uci()));
+    });
+}
+
+void Uci::stop_search() {
+    stop.store(true, std::memory_order_relaxed);
+    search_thread.wait();
 }
 
 }
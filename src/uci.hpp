@@ -1,8 +1,24 @@
 #ifndef VOLTA_UCI_HPP__
 #define VOLTA_UCI_HPP__
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "book.hpp"
 #include "move.hpp"
+#include "nnue.hpp"
 #include "position.hpp"
+#include "search.hpp"
+#include "threadpool.hpp"
+#include "tt.hpp"
+#include "utility.hpp"
 
 namespace Volta {
 
@@ -12,6 +28,62 @@ using namespace Chess;
 
 Move move_from_uci(const PositionState& pos, std::string_view token);
 
+// Writes one line to standard output. Safe to call from the search thread.
+void send(const std::string& line);
+
+// UCI front end. Standard input is read on its own thread, which raises the stop flag as soon as
+// it sees `stop` or `quit`, so a running search notices within one poll interval regardless of
+// what the command thread is doing. Searches run on a single-worker pool; with `Threads` above one,
+// the extra search threads live in a second pool that is rebuilt whenever the option changes. With
+// `OwnBook` set, `go` answers from the `BookFile` book without searching whenever it can.
+class Uci {
+   public:
+    Uci();
+    ~Uci();
+
+    Uci(const Uci&)            = delete;
+    Uci& operator=(const Uci&) = delete;
+
+    // Processes commands until `quit` or end of input.
+    void loop();
+
+   private:
+    using Tokens = std::vector<std::string_view>;
+
+    void read_input();
+    bool next_command(std::string& line);
+    bool execute(const Tokens& tokens);
+
+    void uci() const;
+    void set_option(const Tokens& tokens);
+    void new_game();
+    void position(const Tokens& tokens);
+    void go(const Tokens& tokens);
+    void stop_search();
+
+    PositionState      pos;
+    TranspositionTable tt;
+    Network            network;
+    Book               book;
+    bool               own_book;
+    Utility::PRNG      book_rng;
+
+    // Keys of the positions before `pos` in the current game, for the search's repetition checks.
+    std::vector<std::uint64_t> history;
+
+    std::atomic<bool>                    stop;
+    Utility::ThreadPool                  search_thread;
+    std::unique_ptr<Utility::ThreadPool> helpers;
+
+    // Histories and pawn hash of each search thread, kept from one `go` to the next.
+    std::vector<std::unique_ptr<ThreadData>> thread_data;
+
+    std::mutex              input_mutex;
+    std::condition_variable input_cv;
+    std::deque<std::string> input;
+    std::thread             reader;
+};
+
 }
 
 }
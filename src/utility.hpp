@@ -99,6 +99,11 @@ class fixed_vector {
         return data_[idx];
     }
 
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr bool      empty() const noexcept { return size_ == 0; }
+
+    static constexpr size_type capacity() noexcept { return N; }
+
     constexpr auto&       front() noexcept { return data_.front(); }
     constexpr const auto& front() const noexcept { return data_.front(); }
 
@@ -0,0 +1,70 @@
+#ifndef VOLTA_ZOBRIST_HPP__
+#define VOLTA_ZOBRIST_HPP__
+
+#include <array>
+#include <cstdint>
+
+#include "castling.hpp"
+#include "common.hpp"
+#include "coordinates.hpp"
+#include "piece.hpp"
+#include "utility.hpp"
+
+namespace Volta::Chess {
+
+namespace Detail {
+
+struct ZobristKeys {
+    using SquareKeys = std::array<std::uint64_t, Square::COUNT()>;
+
+    std::array<SquareKeys, PieceType::COUNT() * Color::COUNT()> piece_square;
+    std::array<std::uint64_t, File::COUNT()>                    en_passant;
+    std::uint64_t                                               side;
+    std::array<std::uint64_t, CastlingRights::COUNT()>          castling;
+};
+
+consteval ZobristKeys generate_zobrist_keys() {
+    Utility::PRNG rng{1070372};
+    ZobristKeys   keys{};
+
+    for (auto& piece_keys : keys.piece_square)
+        for (auto& key : piece_keys)
+            key = rng.rand();
+
+    for (auto& key : keys.en_passant)
+        key = rng.rand();
+
+    keys.side = rng.rand();
+
+    // One key per rights mask, with the empty mask hashing to zero.
+    for (std::size_t rights = 1; rights < CastlingRights::COUNT(); rights++)
+        keys.castling[rights] = rng.rand();
+
+    return keys;
+}
+
+}
+
+class Zobrist {
+   private:
+    static constexpr Detail::ZobristKeys Keys = Detail::generate_zobrist_keys();
+
+   public:
+    static constexpr std::uint64_t piece_square(Piece piece, Square sq) {
+        return Keys.piece_square[piece.to_underlying()][sq.ordinal()];
+    }
+
+    static constexpr std::uint64_t en_passant(File file) {
+        return Keys.en_passant[file.to_underlying()];
+    }
+
+    static constexpr std::uint64_t side() { return Keys.side; }
+
+    static constexpr std::uint64_t castling(CastlingRights rights) {
+        return Keys.castling[rights.to_underlying()];
+    }
+};
+
+}
+
+#endif
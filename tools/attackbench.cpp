@@ -0,0 +1,93 @@
+// Times sliding-attack lookups through the Attacks interface, and pseudo-legal move generation on
+// a few standard positions, for whichever backend the binary was built with. `make bench-attacks`
+// builds and runs it for both the magic and the PEXT backend.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "../src/attacks.hpp"
+#include "../src/movegen.hpp"
+#include "../src/position.hpp"
+#include "../src/utility.hpp"
+
+namespace {
+
+using namespace Volta::Chess;
+
+struct Query {
+    Square   sq;
+    BitBoard occ;
+};
+
+template<typename Function>
+void bench(const char* name, const std::vector<Query>& queries, Function&& attacks_fn) {
+    constexpr std::size_t rounds = 200;
+
+    BitBoard   checksum{};
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t round = 0; round < rounds; round++)
+        for (const Query& query : queries)
+            checksum ^= attacks_fn(query.sq, query.occ ^ checksum);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double                        lookups = static_cast<double>(rounds * queries.size());
+
+    std::printf("%-6s %-7s %8.3f ns/lookup %10.1f M lookups/s (checksum %016llx)\n",
+                Attacks::slider_backend(), name, elapsed.count() * 1e9 / lookups,
+                lookups / elapsed.count() / 1e6,
+                static_cast<unsigned long long>(static_cast<std::uint64_t>(checksum)));
+}
+
+void bench_movegen() {
+    constexpr std::size_t rounds = 200000;
+
+    const std::vector<PositionState> positions = {
+      PositionState::startpos(),
+      PositionState::from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w - - 0 1"),
+      PositionState::from_fen("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"),
+      PositionState::from_fen("r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b - - 0 1"),
+      PositionState::from_fen("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w - - 1 8"),
+      PositionState::from_fen(
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10")};
+
+    std::size_t generated = 0;
+    const auto  start     = std::chrono::steady_clock::now();
+
+    for (std::size_t round = 0; round < rounds; round++)
+    {
+        for (const PositionState& pos : positions)
+        {
+            MoveList moves;
+            append_all_moves(moves, pos);
+            generated += moves.size();
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double calls = static_cast<double>(rounds * positions.size());
+
+    std::printf("%-6s %-7s %8.3f ns/call   %10.1f M moves/s   (%zu moves)\n",
+                Attacks::slider_backend(), "movegen", elapsed.count() * 1e9 / calls,
+                generated / elapsed.count() / 1e6, generated);
+}
+
+}
+
+int main() {
+    Volta::Utility::PRNG rng{20240601};
+    std::vector<Query>   queries;
+
+    // Sparse random occupancies look like middlegame boards. Feeding the previous result back
+    // into the occupancy makes each lookup depend on the one before it, which measures latency.
+    for (std::size_t i = 0; i < (1 << 16); i++)
+        queries.push_back({Square::from_ordinal(rng.rand() % Square::COUNT()),
+                           BitBoard(rng.rand() & rng.rand())});
+
+    bench("bishop", queries, Attacks::bishop_attacks);
+    bench("rook", queries, Attacks::rook_attacks);
+    bench("queen", queries, Attacks::queen_attacks);
+    bench_movegen();
+}
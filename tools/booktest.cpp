@@ -0,0 +1,161 @@
+// Checks Polyglot keys against the reference values from the book format specification, then
+// writes a small book to a temporary file and checks that probing decodes its moves, castling
+// and promotions included, and draws them by weight. Build and run with `make test-book`.
+//
+// The exit status is non-zero on any failure.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../src/book.hpp"
+#include "../src/movegen.hpp"
+#include "../src/position.hpp"
+
+namespace {
+
+using namespace Volta::Chess;
+using namespace Volta::Engine;
+
+struct KeyCase {
+    std::string_view fen;
+    std::uint64_t    key;
+};
+
+const std::vector<KeyCase> KeyCases = {
+  {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463B96181691FC9C},
+  {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823C9B50FD114196},
+  {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756B94461C50FB0},
+  {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662FAFB965DB29D4},
+  {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22A48B5A8E47FF78},
+  {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652A607CA3F242C1},
+  {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00FDD303C946BDD9},
+  {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3C8123EA7B067637},
+  {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5C3F9B829B279560}};
+
+struct BookCase {
+    std::string_view fen;
+    std::string_view polyglot_move;
+    std::uint16_t    weight;
+    std::string_view expected;
+};
+
+// Castling is stored as the king taking its own rook.
+const std::vector<BookCase> BookCases = {
+  {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "e2e4", 3, "e2e4"},
+  {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "d2d4", 1, "d2d4"},
+  {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "g1f3", 0, "g1f3"},
+  {"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", "e1h1", 1, "e1g1"},
+  {"r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1", "e8a8", 1, "e8c8"},
+  {"8/P6k/8/8/8/8/8/K7 w - - 0 1", "a7a8n", 1, "a7a8n"}};
+
+constexpr std::size_t DRAWS = 4000;
+
+std::uint16_t encode(const std::string_view uci) {
+    const auto square = [&](std::size_t i) { return (uci[i + 1] - '1') * 8 + (uci[i] - 'a'); };
+
+    std::uint16_t move = static_cast<std::uint16_t>(square(0) << 6 | square(2));
+
+    if (uci.size() == 5)
+        move |= static_cast<std::uint16_t>(std::string_view("nbrq").find(uci[4]) + 1) << 12;
+
+    return move;
+}
+
+void put_big_endian(std::vector<unsigned char>& out, std::uint64_t value, std::size_t bytes) {
+    for (std::size_t i = bytes; i-- > 0;)
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+}
+
+// Book entries must be sorted by key; entries of one key keep the order they are listed in.
+std::string write_book() {
+    std::vector<std::pair<std::uint64_t, const BookCase*>> sorted;
+
+    for (const BookCase& test : BookCases)
+        sorted.emplace_back(Book::polyglot_key(PositionState::from_fen(test.fen)), &test);
+
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    std::vector<unsigned char> bytes;
+
+    for (const auto& [key, test] : sorted)
+    {
+        put_big_endian(bytes, key, 8);
+        put_big_endian(bytes, encode(test->polyglot_move), 2);
+        put_big_endian(bytes, test->weight, 2);
+        put_big_endian(bytes, 0, 4);
+    }
+
+    char path[] = "/tmp/volta-booktest-XXXXXX";
+    const int fd = ::mkstemp(path);
+
+    if (fd < 0 || ::write(fd, bytes.data(), bytes.size()) != static_cast<ssize_t>(bytes.size()))
+        return {};
+
+    ::close(fd);
+    return path;
+}
+
+}
+
+int main() {
+    std::size_t failures = 0;
+
+    for (const KeyCase& test : KeyCases)
+    {
+        const std::uint64_t key = Book::polyglot_key(PositionState::from_fen(test.fen));
+        const bool          ok  = key == test.key;
+
+        std::printf("%s %-64s %016llx\n", ok ? "ok  " : "FAIL", test.fen.data(),
+                    static_cast<unsigned long long>(key));
+        failures += !ok;
+    }
+
+    const std::string path = write_book();
+    Book              book;
+
+    if (path.empty() || !book.open(path))
+    {
+        std::printf("FAIL could not write and open a test book\n");
+        return EXIT_FAILURE;
+    }
+
+    ::unlink(path.c_str());
+
+    Volta::Utility::PRNG rng{42};
+
+    // Every position but the first has a single move; the first draws e2e4 and d2d4 3:1.
+    for (const BookCase& test : BookCases)
+    {
+        const PositionState pos = PositionState::from_fen(test.fen);
+
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < DRAWS; i++)
+            hits += book.probe(pos, rng).to_uci() == test.expected;
+
+        const std::size_t total  = test.fen == BookCases[0].fen ? 4 : test.weight;
+        const std::size_t wanted = total ? DRAWS * test.weight / total : 0;
+        const bool        ok     = hits + DRAWS / 20 >= wanted && hits <= wanted + DRAWS / 20;
+
+        std::printf("%s %-40s %-5s -> %-5s %4zu/%zu draws, expected about %zu\n",
+                    ok ? "ok  " : "FAIL", test.fen.data(), test.polyglot_move.data(),
+                    test.expected.data(), hits, DRAWS, wanted);
+        failures += !ok;
+    }
+
+    const bool missing = book.probe(PositionState::from_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1"), rng)
+                      == Move::NONE();
+
+    std::printf("%s position outside the book\n", missing ? "ok  " : "FAIL");
+    failures += !missing;
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,35 @@
+// Searches the magic multipliers baked into src/magics.hpp and prints them as C++ arrays.
+// Build and run with `make magics`.
+
+#include <cstdint>
+#include <cstdio>
+
+#include "../src/attacks.hpp"
+#include "../src/magics.hpp"
+
+namespace {
+
+using namespace Volta::Chess;
+
+template<typename Function>
+void print_magics(const char* name, Function&& find_magic) {
+    std::printf("inline constexpr std::array<std::uint64_t, Square::COUNT()> %s = {\n", name);
+
+    for (std::size_t sq_idx = 0; sq_idx < Square::COUNT(); sq_idx++)
+    {
+        const Detail::MagicEntry entry = find_magic(Square::from_ordinal(sq_idx));
+        const bool               last  = sq_idx + 1 == Square::COUNT();
+
+        std::printf("%s0x%016llxULL%s", sq_idx % 3 == 0 ? "  " : " ",
+                    static_cast<unsigned long long>(entry.magic),
+                    last ? "};\n" : (sq_idx % 3 == 2 ? ",\n" : ","));
+    }
+}
+
+}
+
+int main() {
+    print_magics("BishopMagicNumbers", find_bishop_magic);
+    std::printf("\n");
+    print_magics("RookMagicNumbers", find_rook_magic);
+}
@@ -0,0 +1,138 @@
+// Plays random games and, at every position, checks that the NATIVE (SIMD) NNUE kernels agree with
+// the scalar ones and that incrementally updated accumulators agree with full refreshes. Build
+// with `make verify-nnue`.
+//
+// volta-nnueverify [<net>]
+//
+// Without a network file the embedded network is used if there is one, and otherwise a random
+// network, which exercises the kernels just as well. The exit status is non-zero on any mismatch.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../src/movegen.hpp"
+#include "../src/nnue.hpp"
+#include "../src/position.hpp"
+#include "../src/utility.hpp"
+
+namespace {
+
+using namespace Volta::Chess;
+using namespace Volta::Engine;
+
+constexpr std::size_t GAMES_PER_POSITION = 64;
+constexpr std::size_t MAX_GAME_PLIES     = 200;
+
+const std::vector<std::string_view> StartPositions = {
+  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+  "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+  "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+  "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"};
+
+// Feature weights are small enough that no accumulator can overflow, but large enough that many
+// activations land outside the clipped-ReLU range on both sides.
+std::vector<std::byte> random_network(std::uint64_t seed) {
+    Volta::Utility::PRNG   rng{seed};
+    std::vector<std::byte> data(Network::file_size());
+    std::byte*             cursor = data.data();
+
+    const auto put = [&cursor](const auto value) {
+        std::memcpy(cursor, &value, sizeof(value));
+        cursor += sizeof(value);
+    };
+
+    put(std::uint32_t{0x314E4E56});
+    put(static_cast<std::uint32_t>(NNUE_HIDDEN));
+
+    for (std::size_t i = 0; i < NNUE_INPUTS * NNUE_HIDDEN + NNUE_HIDDEN; i++)
+        put(static_cast<std::int16_t>(static_cast<std::int32_t>(rng.rand() % 128) - 64));
+
+    for (std::size_t i = 0; i < 2 * NNUE_HIDDEN; i++)
+        put(static_cast<std::int8_t>(rng.rand() & 0xFF));
+
+    put(static_cast<std::int32_t>(rng.rand() % 20001) - 10000);
+
+    return data;
+}
+
+bool same(const Accumulator& lhs, const Accumulator& rhs) {
+    return std::memcmp(lhs.values.data(), rhs.values.data(), sizeof(lhs.values)) == 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto network = std::make_unique<Network>();
+
+    if (argc > 1 ? !network->load_file(argv[1])
+                 : !network->load_embedded() && !network->load_buffer(random_network(20240601)))
+    {
+        std::fprintf(stderr, "failed to load network\n");
+        return EXIT_FAILURE;
+    }
+
+    Volta::Utility::PRNG rng{42};
+
+    auto parent_native = std::make_unique<Accumulator>();
+    auto parent_scalar = std::make_unique<Accumulator>();
+    auto child_native  = std::make_unique<Accumulator>();
+    auto child_scalar  = std::make_unique<Accumulator>();
+    auto refreshed     = std::make_unique<Accumulator>();
+
+    std::uint64_t positions     = 0;
+    std::uint64_t acc_mismatch  = 0;
+    std::uint64_t eval_mismatch = 0;
+
+    for (const std::string_view fen : StartPositions)
+    {
+        for (std::size_t game = 0; game < GAMES_PER_POSITION; game++)
+        {
+            PositionState pos = PositionState::from_fen(fen);
+
+            network->refresh(pos, *parent_native, NnueKernel::NATIVE);
+            network->refresh(pos, *parent_scalar, NnueKernel::SCALAR);
+
+            for (std::size_t ply = 0; ply < MAX_GAME_PLIES; ply++)
+            {
+                MoveList moves;
+                append_legal_moves(moves, pos);
+
+                if (moves.empty())
+                    break;
+
+                pos.make_move(moves[rng.rand() % moves.size()]);
+
+                network->update(*parent_native, *child_native, pos.dirty_pieces(),
+                                NnueKernel::NATIVE);
+                network->update(*parent_scalar, *child_scalar, pos.dirty_pieces(),
+                                NnueKernel::SCALAR);
+                network->refresh(pos, *refreshed, NnueKernel::SCALAR);
+
+                positions++;
+
+                if (!same(*child_native, *refreshed) || !same(*child_scalar, *refreshed))
+                    acc_mismatch++;
+
+                if (network->evaluate(*child_native, pos.stm(), NnueKernel::NATIVE)
+                    != network->evaluate(*child_scalar, pos.stm(), NnueKernel::SCALAR))
+                    eval_mismatch++;
+
+                std::swap(parent_native, child_native);
+                std::swap(parent_scalar, child_scalar);
+            }
+        }
+    }
+
+    std::printf("kernel: %s\npositions: %llu\naccumulator mismatches: %llu\n"
+                "evaluation mismatches: %llu\n",
+                Network::kernel_name(), static_cast<unsigned long long>(positions),
+                static_cast<unsigned long long>(acc_mismatch),
+                static_cast<unsigned long long>(eval_mismatch));
+
+    return acc_mismatch == 0 && eval_mismatch == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
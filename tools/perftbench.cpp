@@ -0,0 +1,227 @@
+// Runs perft over the standard verification suite, checks every count against the published
+// value and reports time and nodes per second per position. Build with `make perftbench`.
+//
+// volta-perftbench [--depth N] [--format text|json|csv]
+//
+// Without --depth each position runs at its default depth. With --depth every position runs at the
+// deepest known count not exceeding N. The exit status is non-zero if any count mismatches.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/attacks.hpp"
+#include "../src/perft.hpp"
+#include "../src/position.hpp"
+
+namespace {
+
+using namespace Volta::Chess;
+
+struct KnownCount {
+    std::int32_t  depth;
+    std::uint64_t nodes;
+};
+
+struct BenchPosition {
+    const char*             name;
+    const char*             fen;
+    std::int32_t            default_depth;
+    std::vector<KnownCount> counts;
+};
+
+struct BenchResult {
+    const BenchPosition* position;
+    std::int32_t         depth;
+    std::uint64_t        nodes;
+    std::uint64_t        expected;
+    double               seconds;
+
+    bool passed() const noexcept { return nodes == expected; }
+};
+
+enum class Format {
+    TEXT,
+    JSON,
+    CSV
+};
+
+// clang-format off
+const std::vector<BenchPosition> Suite = {
+  {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 6,
+   {{1, 20}, {2, 400}, {3, 8902}, {4, 197281}, {5, 4865609}, {6, 119060324}}},
+  {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 5,
+   {{1, 48}, {2, 2039}, {3, 97862}, {4, 4085603}, {5, 193690690}}},
+  {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6,
+   {{1, 14}, {2, 191}, {3, 2812}, {4, 43238}, {5, 674624}, {6, 11030083}, {7, 178633661}}},
+  {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5,
+   {{1, 6}, {2, 264}, {3, 9467}, {4, 422333}, {5, 15833292}}},
+  {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 5,
+   {{1, 44}, {2, 1486}, {3, 62379}, {4, 2103487}, {5, 89941194}}},
+  {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 5,
+   {{1, 46}, {2, 2079}, {3, 89890}, {4, 3894594}, {5, 164075551}}},
+  {"ep-pin", "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, {{6, 1134888}}},
+  {"ep-check", "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, {{6, 1440467}}},
+  {"ep-diagonal", "8/5bk1/8/2Pp4/8/1K6/8/8 w - d6 0 1", 6, {{6, 824064}}},
+  {"ep-discovered", "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", 6, {{6, 1015133}}},
+  {"promo-evasion", "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 6, {{6, 3821001}}},
+  {"promo-check", "4k3/1P6/8/8/8/8/K7/8 w - - 0 1", 6, {{6, 217342}}},
+  {"underpromo-check", "8/P1k5/K7/8/8/8/8/8 w - - 0 1", 6, {{6, 92683}}},
+  {"promo-stalemate", "8/k1P5/8/1K6/8/8/8/8 w - - 0 1", 7, {{7, 567584}}},
+  {"self-stalemate", "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, {{6, 2217}}},
+  {"castle-check", "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, {{6, 661072}}},
+  {"long-castle-check", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, {{6, 803711}}},
+  {"castle-rights", "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, {{4, 1274206}}},
+  {"castle-prevented", "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, {{4, 1720476}}},
+  {"discovered-check", "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, {{5, 1004658}}},
+  {"double-check", "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, {{4, 23527}}}};
+// clang-format on
+
+const KnownCount* select_count(const BenchPosition& position, std::int32_t max_depth) {
+    const std::int32_t target  = max_depth > 0 ? max_depth : position.default_depth;
+    const KnownCount*  current = nullptr;
+
+    for (const KnownCount& known : position.counts)
+        if (known.depth <= target)
+            current = &known;
+
+    return current;
+}
+
+BenchResult run(const BenchPosition& position, const KnownCount& known) {
+    const PositionState pos   = PositionState::from_fen(position.fen);
+    const auto          start = std::chrono::steady_clock::now();
+    const std::uint64_t nodes = perft(pos, known.depth);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return {&position, known.depth, nodes, known.nodes, elapsed.count()};
+}
+
+std::uint64_t nps(std::uint64_t nodes, double seconds) {
+    return seconds > 0 ? static_cast<std::uint64_t>(nodes / seconds) : 0;
+}
+
+void print_text(const std::vector<BenchResult>& results) {
+    std::printf("%-18s %5s %12s %12s %10s %14s  %s\n", "position", "depth", "nodes", "expected",
+                "time (s)", "nps", "result");
+
+    for (const BenchResult& result : results)
+        std::printf("%-18s %5d %12llu %12llu %10.3f %14llu  %s\n", result.position->name,
+                    result.depth, static_cast<unsigned long long>(result.nodes),
+                    static_cast<unsigned long long>(result.expected), result.seconds,
+                    static_cast<unsigned long long>(nps(result.nodes, result.seconds)),
+                    result.passed() ? "ok" : "MISMATCH");
+}
+
+void print_json(const std::vector<BenchResult>& results) {
+    std::printf("{\n  \"backend\": \"%s\",\n  \"positions\": [\n", Attacks::slider_backend());
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& result = results[i];
+
+        std::printf("    {\"name\": \"%s\", \"depth\": %d, \"nodes\": %llu, \"expected\": %llu, "
+                    "\"seconds\": %.6f, \"nps\": %llu, \"passed\": %s}%s\n",
+                    result.position->name, result.depth,
+                    static_cast<unsigned long long>(result.nodes),
+                    static_cast<unsigned long long>(result.expected), result.seconds,
+                    static_cast<unsigned long long>(nps(result.nodes, result.seconds)),
+                    result.passed() ? "true" : "false", i + 1 < results.size() ? "," : "");
+    }
+
+    std::printf("  ],\n");
+}
+
+void print_csv(const std::vector<BenchResult>& results) {
+    std::printf("backend,name,depth,nodes,expected,seconds,nps,passed\n");
+
+    for (const BenchResult& result : results)
+        std::printf("%s,%s,%d,%llu,%llu,%.6f,%llu,%d\n", Attacks::slider_backend(),
+                    result.position->name, result.depth,
+                    static_cast<unsigned long long>(result.nodes),
+                    static_cast<unsigned long long>(result.expected), result.seconds,
+                    static_cast<unsigned long long>(nps(result.nodes, result.seconds)),
+                    result.passed() ? 1 : 0);
+}
+
+void print_total(Format format, std::uint64_t nodes, double seconds, bool passed) {
+    switch (format)
+    {
+    case Format::TEXT :
+        std::printf("\ntotal: %llu nodes in %.3f s, %llu nps, %s\n",
+                    static_cast<unsigned long long>(nodes), seconds,
+                    static_cast<unsigned long long>(nps(nodes, seconds)),
+                    passed ? "all counts match" : "COUNT MISMATCH");
+        break;
+    case Format::JSON :
+        std::printf("  \"total_nodes\": %llu,\n  \"total_seconds\": %.6f,\n  \"nps\": %llu,\n"
+                    "  \"passed\": %s\n}\n",
+                    static_cast<unsigned long long>(nodes), seconds,
+                    static_cast<unsigned long long>(nps(nodes, seconds)),
+                    passed ? "true" : "false");
+        break;
+    case Format::CSV :
+        std::printf("%s,total,,%llu,,%.6f,%llu,%d\n", Attacks::slider_backend(),
+                    static_cast<unsigned long long>(nodes), seconds,
+                    static_cast<unsigned long long>(nps(nodes, seconds)), passed ? 1 : 0);
+        break;
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+
+    std::int32_t max_depth = 0;
+    Format       format    = Format::TEXT;
+
+    for (std::size_t i = 0; i + 1 < args.size(); i += 2)
+    {
+        if (args[i] == "--depth")
+            max_depth = std::stoi(std::string(args[i + 1]));
+        else if (args[i] == "--format" && args[i + 1] == "json")
+            format = Format::JSON;
+        else if (args[i] == "--format" && args[i + 1] == "csv")
+            format = Format::CSV;
+    }
+
+    std::vector<BenchResult> results;
+
+    for (const BenchPosition& position : Suite)
+        if (const KnownCount* known = select_count(position, max_depth))
+            results.push_back(run(position, *known));
+
+    std::uint64_t total_nodes   = 0;
+    double        total_seconds = 0.0;
+    bool          passed        = true;
+
+    for (const BenchResult& result : results)
+    {
+        total_nodes += result.nodes;
+        total_seconds += result.seconds;
+        passed = passed && result.passed();
+    }
+
+    switch (format)
+    {
+    case Format::TEXT :
+        print_text(results);
+        break;
+    case Format::JSON :
+        print_json(results);
+        break;
+    case Format::CSV :
+        print_csv(results);
+        break;
+    }
+
+    print_total(format, total_nodes, total_seconds, passed);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
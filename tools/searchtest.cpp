@@ -0,0 +1,60 @@
+// Searches hand-picked positions to a fixed depth and checks the best move. Build and run with
+// `make test-search`.
+//
+// The exit status is non-zero on any failure.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "../src/position.hpp"
+#include "../src/search.hpp"
+#include "../src/tt.hpp"
+
+namespace {
+
+using namespace Volta::Chess;
+using namespace Volta::Engine;
+
+struct SearchCase {
+    std::string_view fen;
+    std::int32_t     depth;
+    std::string_view expected;
+};
+
+const std::vector<SearchCase> SearchCases = {
+  // Back-rank mate.
+  {"6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 80", 3, "a1a8"},
+  // The same mate on the hundredth halfmove: checkmate wins over the fifty-move rule.
+  {"6k1/5ppp/8/8/8/8/8/R5K1 w - - 99 80", 3, "a1a8"}};
+
+}  // namespace
+
+int main() {
+    std::size_t failures = 0;
+
+    for (const SearchCase& test : SearchCases)
+    {
+        TranspositionTable                       tt{16};
+        std::vector<std::unique_ptr<ThreadData>> thread_data;
+        std::atomic<bool>                        stop{false};
+        SearchLimits                             limits;
+
+        limits.depth = test.depth;
+
+        const PositionState pos = PositionState::from_fen(test.fen);
+        const Move          best =
+          search(pos, {}, limits, stop, tt, nullptr, nullptr, thread_data, false).best_move;
+        const bool ok = best.to_uci() == test.expected;
+
+        std::printf("%s %-40s depth %d -> %-5s expected %s\n", ok ? "ok  " : "FAIL",
+                    test.fen.data(), test.depth, best.to_uci().c_str(), test.expected.data());
+        failures += !ok;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+// Checks static exchange evaluation against hand-worked positions, then plays random games and
+// checks that see_ge agrees with see at every capture. Build and run with `make test-see`.
+//
+// Values are P=100 N=320 B=330 R=500 Q=900. The exit status is non-zero on any failure.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+#include "../src/movegen.hpp"
+#include "../src/position.hpp"
+#include "../src/utility.hpp"
+
+namespace {
+
+using namespace Volta::Chess;
+
+struct SeeCase {
+    std::string_view fen;
+    std::string_view move;
+    std::int32_t     expected;
+};
+
+const std::vector<SeeCase> SeeCases = {
+  // Rook takes an undefended pawn.
+  {"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5", 100},
+  // Knight takes a pawn defended by a knight, with a queen and rook lined up on both sides.
+  {"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3e5", -220},
+  {"4k3/8/8/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5", 100},
+  {"4k3/8/2p5/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5", 0},
+  {"4k3/8/2p5/3p4/8/8/3Q4/4K3 w - - 0 1", "d2d5", -800},
+  {"4k3/8/2p5/3r4/8/4N3/8/4K3 w - - 0 1", "e3d5", 180},
+  // The second rook only sees d5 once the first one has left d2.
+  {"3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", 100},
+  {"8/8/4k3/3p4/8/8/8/3RK3 w - - 0 1", "d1d5", -400},
+  // The king cannot recapture onto a square the second rook defends.
+  {"8/8/4k3/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", 100},
+  // Quiet moves lose the moved piece if it can be taken for free.
+  {"4k3/8/1p6/8/8/8/8/R3K3 w - - 0 1", "a1a5", -500},
+  {"4k3/8/8/8/8/8/8/R3K3 w - - 0 1", "a1a5", 0},
+  // Bishop x-rays through a queen.
+  {"4k3/8/8/3p4/2Q5/1B6/8/4K3 w - - 0 1", "c4d5", 100},
+  {"4k3/8/5n2/3p4/2Q5/1B6/8/4K3 w - - 0 1", "c4d5", -480},
+  // En passant and promotions are not evaluated.
+  {"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6", 0},
+  {"3rk3/2P5/8/8/8/8/8/4K3 w - - 0 1", "c7d8q", 0}};
+
+const std::vector<std::string_view> StartPositions = {
+  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+  "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+  "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+  "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"};
+
+constexpr std::size_t GAMES_PER_POSITION = 64;
+constexpr std::size_t MAX_GAME_PLIES     = 200;
+
+Move find_move(const PositionState& pos, const std::string_view uci) {
+    MoveList moves;
+    append_legal_moves(moves, pos);
+
+    for (const Move move : moves)
+        if (move.to_uci() == uci)
+            return move;
+
+    return Move::NONE();
+}
+
+// see_ge has to agree with see exactly at the boundary.
+bool consistent(const PositionState& pos, const Move move, const std::int32_t value) {
+    return pos.see_ge(move, value) && !pos.see_ge(move, value + 1);
+}
+
+}
+
+int main() {
+    std::size_t failures = 0;
+
+    for (const SeeCase& test : SeeCases)
+    {
+        const PositionState pos  = PositionState::from_fen(test.fen);
+        const Move          move = find_move(pos, test.move);
+
+        if (move == Move::NONE())
+        {
+            std::printf("FAIL %s %.*s: no such move\n", test.fen.data(),
+                        static_cast<int>(test.move.size()), test.move.data());
+            failures++;
+            continue;
+        }
+
+        const std::int32_t value = pos.see(move);
+        const bool         ok    = value == test.expected && consistent(pos, move, test.expected);
+
+        std::printf("%s %-60s %-5.*s see %5d expected %5d\n", ok ? "ok  " : "FAIL",
+                    test.fen.data(), static_cast<int>(test.move.size()), test.move.data(), value,
+                    test.expected);
+
+        failures += !ok;
+    }
+
+    Volta::Utility::PRNG rng{42};
+    std::uint64_t        checked      = 0;
+    std::uint64_t        inconsistent = 0;
+
+    for (const std::string_view fen : StartPositions)
+    {
+        for (std::size_t game = 0; game < GAMES_PER_POSITION; game++)
+        {
+            PositionState pos = PositionState::from_fen(fen);
+
+            for (std::size_t ply = 0; ply < MAX_GAME_PLIES; ply++)
+            {
+                MoveList moves;
+                append_legal_moves(moves, pos);
+
+                if (moves.empty())
+                    break;
+
+                for (const Move move : moves)
+                {
+                    if (!move.is_capture())
+                        continue;
+
+                    checked++;
+                    inconsistent += !consistent(pos, move, pos.see(move));
+                }
+
+                pos.make_move(moves[rng.rand() % moves.size()]);
+            }
+        }
+    }
+
+    std::printf("random captures: %llu\nsee/see_ge mismatches: %llu\n",
+                static_cast<unsigned long long>(checked),
+                static_cast<unsigned long long>(inconsistent));
+
+    return failures == 0 && inconsistent == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,83 @@
+// Fills a transposition table with random keys and checks that every key it still holds probes
+// back with its data, and that keys which were never stored miss. Only the 16-bit fragment
+// verifies a key within its bucket, so a few false hits are expected; many of them mean the
+// fragment overlaps the bits that choose the bucket. Build and run with `make test-tt`.
+//
+// The exit status is non-zero on any failure.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../src/tt.hpp"
+#include "../src/utility.hpp"
+
+namespace {
+
+using namespace Volta::Engine;
+
+constexpr std::size_t HASH_MB = 16;
+constexpr std::size_t STORED  = 100000;
+constexpr std::size_t PROBES  = 100000;
+
+// Three entries per bucket give about 3 / 65536 false hits per probe of a full table.
+constexpr std::size_t MAX_FALSE_HITS = 50;
+
+// A payload derived from the key, so that a hit can be checked against what was stored.
+Value value_of(std::uint64_t key) { return static_cast<Value>(key % 2001) - 1000; }
+
+}  // namespace
+
+int main() {
+    TranspositionTable   tt{HASH_MB};
+    Volta::Utility::PRNG stored_keys{1};
+    std::size_t          failures = 0;
+
+    tt.new_search();
+
+    for (std::size_t i = 0; i < STORED; i++)
+    {
+        const std::uint64_t key = stored_keys.rand();
+        tt.store(key, Move::NONE(), value_of(key), value_of(key), 10, Bound::EXACT);
+    }
+
+    // Later stores can evict earlier ones, so only check that hits carry the right data.
+    Volta::Utility::PRNG replay{1};
+    std::size_t          hits       = 0;
+    std::size_t          wrong_data = 0;
+
+    for (std::size_t i = 0; i < STORED; i++)
+    {
+        const std::uint64_t key = replay.rand();
+        TTData              data;
+
+        if (!tt.probe(key, data))
+            continue;
+
+        hits++;
+        wrong_data += data.value != value_of(key) || data.depth != 10 || data.bound != Bound::EXACT;
+    }
+
+    const bool stored_ok = hits > STORED * 9 / 10 && wrong_data == 0;
+
+    std::printf("%s stored keys: %zu/%zu hit, %zu with wrong data\n", stored_ok ? "ok  " : "FAIL",
+                hits, STORED, wrong_data);
+    failures += !stored_ok;
+
+    Volta::Utility::PRNG fresh_keys{2};
+    std::size_t          false_hits = 0;
+
+    for (std::size_t i = 0; i < PROBES; i++)
+    {
+        TTData data;
+        false_hits += tt.probe(fresh_keys.rand(), data);
+    }
+
+    const bool fresh_ok = false_hits <= MAX_FALSE_HITS;
+
+    std::printf("%s keys never stored: %zu/%zu false hits, at most %zu allowed\n",
+                fresh_ok ? "ok  " : "FAIL", false_hits, PROBES, MAX_FALSE_HITS);
+    failures += !fresh_ok;
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}